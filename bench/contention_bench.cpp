@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "../include/singleton.hpp"
+
+// Contention on the lock a singleton is created under.
+// Startup scenario: every thread is released at once into
+// ThreadingModel<T>::Lock while the winner holds it for kConstructTime,
+// the way a slow constructor would. Reports wall time until the last
+// thread got through and the process CPU time burned meanwhile.
+// Handoff scenario: every thread repeatedly takes the lock around a tiny
+// critical section; reports acquisitions per second.
+// Herd scenario: the same startup stampede, but through Singleton::Instance()
+// with a kConstructTime constructor, so models that do not create under
+// their Lock (OnceInit) are compared too.
+
+namespace {
+
+    constexpr auto kConstructTime = std::chrono::milliseconds(20);
+    constexpr auto kHandoffWindow = std::chrono::milliseconds(200);
+
+    void BusyFor(std::chrono::steady_clock::duration d) {
+        auto end = std::chrono::steady_clock::now() + d;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+
+    struct StartupResult {
+        double wallMs;
+        double cpuMs;
+    };
+
+    template <typename Lock>
+    StartupResult RunStartup(unsigned threads) {
+        std::atomic<bool> start{ false };
+        std::atomic<bool> constructed{ false };
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                Lock guard;
+                if (!constructed.load(std::memory_order_relaxed)) {
+                    BusyFor(kConstructTime);
+                    constructed.store(true, std::memory_order_relaxed);
+                }
+                });
+        }
+
+        std::clock_t cpuBegin = std::clock();
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - begin;
+        double cpu = 1000.0 * static_cast<double>(std::clock() - cpuBegin) / CLOCKS_PER_SEC;
+        return { wall.count(), cpu };
+    }
+
+    template <typename Lock>
+    double RunHandoff(unsigned threads) {
+        std::atomic<bool> start{ false };
+        std::atomic<bool> stop{ false };
+        std::atomic<unsigned long long> total{ 0 };
+        unsigned long long shared = 0;
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                unsigned long long n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    Lock guard;
+                    ++shared;
+                    ++n;
+                }
+                total.fetch_add(n, std::memory_order_relaxed);
+                });
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(kHandoffWindow);
+        stop.store(true, std::memory_order_relaxed);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        return static_cast<double>(total.load()) / elapsed.count();
+    }
+
+    template <typename Tag>
+    struct SlowPayload {
+        SlowPayload() { BusyFor(kConstructTime); }
+    };
+
+    template <typename S>
+    StartupResult RunHerd(unsigned threads) {
+        dp::detail::SingletonAccess<S>::Reset();
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                S::Instance();
+                });
+        }
+
+        std::clock_t cpuBegin = std::clock();
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - begin;
+        double cpu = 1000.0 * static_cast<double>(std::clock() - cpuBegin) / CLOCKS_PER_SEC;
+        return { wall.count(), cpu };
+    }
+
+    template <template <typename> class ThreadingModel>
+    void RunHerdTable(const char* name, unsigned maxThreads) {
+        struct Tag {};
+        using S = dp::Singleton<SlowPayload<Tag>, dp::CreateUsingNew, dp::NoDestroy, ThreadingModel>;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            StartupResult herd = RunHerd<S>(threads);
+            std::printf("%-20s %8u %14.2f %14.2f\n", name, threads, herd.wallMs, herd.cpuMs);
+        }
+    }
+
+    template <template <typename> class ThreadingModel>
+    void Run(const char* name, unsigned maxThreads) {
+        // Distinct tag per model so each gets its own static lock
+        struct Tag {};
+        using Lock = typename ThreadingModel<Tag>::Lock;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            StartupResult startup = RunStartup<Lock>(threads);
+            double handoff = RunHandoff<Lock>(threads);
+            std::printf("%-20s %8u %14.2f %14.2f %16.0f\n",
+                name, threads, startup.wallMs, startup.cpuMs, handoff);
+        }
+    }
+
+} // namespace
+
+int main() {
+    unsigned maxThreads = std::max(4u, 2 * std::thread::hardware_concurrency());
+
+    std::printf("%-20s %8s %14s %14s %16s\n",
+        "threading model", "threads", "startup ms", "startup cpu ms", "handoffs/s");
+    Run<dp::ClassLevelLockable>("ClassLevelLockable", maxThreads);
+    Run<dp::AtomicLockable>("AtomicLockable", maxThreads);
+    Run<dp::SpinParkLockable>("SpinParkLockable", maxThreads);
+
+    std::printf("\n%-20s %8s %14s %14s\n", "threading model", "threads", "herd ms", "herd cpu ms");
+    RunHerdTable<dp::ClassLevelLockable>("ClassLevelLockable", maxThreads);
+    RunHerdTable<dp::AtomicLockable>("AtomicLockable", maxThreads);
+    RunHerdTable<dp::SpinParkLockable>("SpinParkLockable", maxThreads);
+    RunHerdTable<dp::OnceInit>("OnceInit", maxThreads);
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "../include/singleton.hpp"
+
+// Steady-state Instance() throughput for each threading model.
+// Every thread hammers Instance() for a fixed wall-clock window and the
+// result is reported as calls per second per thread (i.e. per core when
+// the thread count does not exceed the core count).
+
+namespace {
+
+    struct Payload {
+        int value = 42;
+    };
+
+    // Keeps the compiler from discarding the Instance() call
+    template <typename T>
+    inline void DoNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    constexpr auto kWindow = std::chrono::milliseconds(200);
+    constexpr int kBatch = 1024;
+
+    template <typename S>
+    double MeasureCallsPerSecondPerThread(unsigned threads) {
+        S::Instance(); // Exclude construction from the measurement
+
+        std::atomic<bool> start{ false };
+        std::atomic<bool> stop{ false };
+        std::vector<unsigned long long> calls(threads, 0);
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                unsigned long long n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < kBatch; ++i) {
+                        DoNotOptimize(&S::Instance());
+                    }
+                    n += kBatch;
+                }
+                calls[t] = n;
+                });
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(kWindow);
+        stop.store(true, std::memory_order_relaxed);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+        unsigned long long total = 0;
+        for (auto n : calls) {
+            total += n;
+        }
+        return static_cast<double>(total) / elapsed.count() / threads;
+    }
+
+    template <template <typename> class ThreadingModel, template <typename> class LifetimePolicy = dp::NoDestroy>
+    void Run(const char* name, unsigned maxThreads) {
+        using S = dp::Singleton<Payload, dp::CreateUsingNew, LifetimePolicy, ThreadingModel>;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            double rate = MeasureCallsPerSecondPerThread<S>(threads);
+            std::printf("%-22s %8u %18.0f\n", name, threads, rate);
+        }
+    }
+
+} // namespace
+
+int main() {
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("%-22s %8s %18s\n", "threading model", "threads", "calls/s/thread");
+    Run<dp::SingleThreaded>("SingleThreaded", 1);
+    Run<dp::ClassLevelLockable>("ClassLevelLockable", maxThreads);
+    Run<dp::AtomicLockable>("AtomicLockable", maxThreads);
+    Run<dp::SpinParkLockable>("SpinParkLockable", maxThreads);
+    Run<dp::AdaptiveLockable>("AdaptiveLockable", maxThreads);
+    Run<dp::OnceInit>("OnceInit", maxThreads);
+    Run<dp::ThreadLocalSingleton, dp::DestroyAtThreadExit>("ThreadLocalSingleton", maxThreads);
+    Run<dp::RecycledThreadLocal, dp::DestroyAtThreadExit>("RecycledThreadLocal", maxThreads);
+    return 0;
+}
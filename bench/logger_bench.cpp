@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include "../include/async_logger.hpp"
+
+// Per-call latency of logging one line: the synchronous
+// "stream << message << std::endl" idiom from the examples versus
+// AsyncLogger::Log(). Both write to /dev/null so only the caller-side
+// cost is measured. Reported as percentiles in nanoseconds.
+
+namespace {
+
+    constexpr int kCalls = 200000;
+
+    template <typename F>
+    std::vector<double> Measure(F&& log) {
+        std::vector<double> samples;
+        samples.reserve(kCalls);
+        for (int i = 0; i < kCalls; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            log(i);
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples;
+    }
+
+    void Report(const char* name, const std::vector<double>& samples) {
+        auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+        std::printf("%-18s %10.0f %10.0f %10.0f\n", name, at(0.50), at(0.99), at(0.999));
+    }
+
+} // namespace
+
+int main() {
+    const std::string message = "request handled in 42us status=200 path=/api/v1/items";
+
+    std::printf("%-18s %10s %10s %10s\n", "logger", "p50 ns", "p99 ns", "p99.9 ns");
+
+    std::ofstream stream("/dev/null");
+    Report("ostream + endl", Measure([&](int) { stream << "LOG: " << message << std::endl; }));
+
+    int fd = ::open("/dev/null", O_WRONLY);
+    {
+        dp::AsyncLogger logger(fd);
+        Report("AsyncLogger", Measure([&](int) { logger.Log(message); }));
+    }
+    ::close(fd);
+    return 0;
+}
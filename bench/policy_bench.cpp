@@ -0,0 +1,211 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include "../include/singleton.hpp"
+#include "../include/arena_policy.hpp"
+
+// Google Benchmark suite over the cross product of creation, lifetime and
+// threading policies. For every combination it registers:
+//   FirstAccess/<policies>  - Instance() on a fresh singleton (create + schedule)
+//   Instance/<policies>     - steady-state Instance() at 1..N threads
+//   Destroy/<policies>      - destruction of a live instance
+// Combinations are generated from the policy lists below; adding a policy
+// to a list (and a PolicyName for it) is all it takes to cover it.
+
+namespace {
+
+    // Compile-time lists of policy templates
+    template <template <typename> class... Policies>
+    struct PolicyList {};
+
+    using CreationPolicies = PolicyList<
+        dp::CreateUsingNew,
+        dp::CreateUsingMalloc,
+        dp::CreateUsingSharedPtr,
+        dp::CreateStatic,
+        dp::CreateInArena
+    >;
+
+    using LifetimePolicies = PolicyList<
+        dp::DefaultLifetime,
+        dp::NoDestroy,
+        dp::PhoenixSingleton,
+        dp::DestroyAtThreadExit,
+        dp::SingletonWithLongevity,
+        dp::FastExit
+    >;
+
+    using ThreadingModels = PolicyList<
+        dp::SingleThreaded,
+        dp::ClassLevelLockable,
+        dp::AtomicLockable,
+        dp::SpinParkLockable,
+        dp::AdaptiveLockable,
+        dp::OnceInit,
+        dp::ThreadLocalSingleton,
+        dp::RecycledThreadLocal
+    >;
+
+    template <template <typename> class Policy>
+    struct PolicyName;
+
+#define DP_BENCH_POLICY_NAME(policy) \
+    template <> struct PolicyName<dp::policy> { static constexpr const char* value = #policy; }
+
+    DP_BENCH_POLICY_NAME(CreateUsingNew);
+    DP_BENCH_POLICY_NAME(CreateUsingMalloc);
+    DP_BENCH_POLICY_NAME(CreateUsingSharedPtr);
+    DP_BENCH_POLICY_NAME(CreateStatic);
+    DP_BENCH_POLICY_NAME(CreateInArena);
+    DP_BENCH_POLICY_NAME(DefaultLifetime);
+    DP_BENCH_POLICY_NAME(NoDestroy);
+    DP_BENCH_POLICY_NAME(PhoenixSingleton);
+    DP_BENCH_POLICY_NAME(DestroyAtThreadExit);
+    DP_BENCH_POLICY_NAME(SingletonWithLongevity);
+    DP_BENCH_POLICY_NAME(FastExit);
+    DP_BENCH_POLICY_NAME(SingleThreaded);
+    DP_BENCH_POLICY_NAME(ClassLevelLockable);
+    DP_BENCH_POLICY_NAME(AtomicLockable);
+    DP_BENCH_POLICY_NAME(SpinParkLockable);
+    DP_BENCH_POLICY_NAME(AdaptiveLockable);
+    DP_BENCH_POLICY_NAME(OnceInit);
+    DP_BENCH_POLICY_NAME(ThreadLocalSingleton);
+    DP_BENCH_POLICY_NAME(RecycledThreadLocal);
+
+#undef DP_BENCH_POLICY_NAME
+
+    template
+        <
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel
+        >
+        struct Combination {};
+
+    // Distinct type per combination, so per-type policy state (static
+    // buffers, shared_ptr slots) is never shared between combinations
+    template <typename Tag>
+    struct Payload {
+        int value = 42;
+        char data[64] = {};
+    };
+
+    template <typename Tag>
+    unsigned int GetLongevity(Payload<Tag>*) { return 1; }
+
+    template <typename Tag>
+    void FlushOnExit(Payload<Tag>&) {}
+
+    // Per-thread instances need a creation policy that can create several
+    // and a lifetime policy that tolerates destruction at thread exit
+    // (the combinations Singleton rejects at compile time)
+    template
+        <
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel
+        >
+    constexpr bool IsSupported() {
+        return !dp::HasPerThreadInstances<ThreadingModel<int>>::value ||
+            (!dp::HoldsSingleInstance<CreationPolicy<int>>::value &&
+                dp::SupportsPerThreadInstances<LifetimePolicy<int>>::value);
+    }
+
+    // Bounded because every creation schedules another exit-time entry
+    constexpr int kLifecycleIterations = 2000;
+
+    template <typename S>
+    void BM_FirstAccess(benchmark::State& state) {
+        for (auto _ : state) {
+            state.PauseTiming();
+            dp::detail::SingletonAccess<S>::Reset();
+            state.ResumeTiming();
+            benchmark::DoNotOptimize(&S::Instance());
+        }
+    }
+
+    template <typename S>
+    void BM_Instance(benchmark::State& state) {
+        benchmark::DoNotOptimize(&S::Instance());
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(&S::Instance());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <typename S>
+    void BM_Destroy(benchmark::State& state) {
+        for (auto _ : state) {
+            state.PauseTiming();
+            benchmark::DoNotOptimize(&S::Instance());
+            state.ResumeTiming();
+            dp::detail::SingletonAccess<S>::Reset();
+        }
+    }
+
+    template
+        <
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel
+        >
+        void RegisterCombination(int maxThreads) {
+        if constexpr (IsSupported<CreationPolicy, LifetimePolicy, ThreadingModel>()) {
+            using T = Payload<Combination<CreationPolicy, LifetimePolicy, ThreadingModel>>;
+            using S = dp::Singleton<T, CreationPolicy, LifetimePolicy, ThreadingModel>;
+
+            std::string name = std::string(PolicyName<CreationPolicy>::value) + "/" +
+                PolicyName<LifetimePolicy>::value + "/" + PolicyName<ThreadingModel>::value;
+
+            benchmark::RegisterBenchmark(("FirstAccess/" + name).c_str(), &BM_FirstAccess<S>)
+                ->Iterations(kLifecycleIterations);
+
+            auto* steady = benchmark::RegisterBenchmark(("Instance/" + name).c_str(), &BM_Instance<S>);
+            if (std::is_same_v<ThreadingModel<T>, dp::SingleThreaded<T>>) {
+                steady->Threads(1);
+            }
+            else {
+                steady->ThreadRange(1, maxThreads)->UseRealTime();
+            }
+
+            benchmark::RegisterBenchmark(("Destroy/" + name).c_str(), &BM_Destroy<S>)
+                ->Iterations(kLifecycleIterations);
+        }
+    }
+
+    template
+        <
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class... ThreadingModel
+        >
+        void RegisterThreading(PolicyList<ThreadingModel...>, int maxThreads) {
+        (RegisterCombination<CreationPolicy, LifetimePolicy, ThreadingModel>(maxThreads), ...);
+    }
+
+    template <template <typename> class CreationPolicy, template <typename> class... LifetimePolicy>
+    void RegisterLifetime(PolicyList<LifetimePolicy...>, int maxThreads) {
+        (RegisterThreading<CreationPolicy, LifetimePolicy>(ThreadingModels{}, maxThreads), ...);
+    }
+
+    template <template <typename> class... CreationPolicy>
+    void RegisterAll(PolicyList<CreationPolicy...>, int maxThreads) {
+        (RegisterLifetime<CreationPolicy>(LifetimePolicies{}, maxThreads), ...);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    RegisterAll(CreationPolicies{}, maxThreads);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
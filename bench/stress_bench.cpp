@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "../include/singleton.hpp"
+
+// Thundering-herd stress test of first access. For each threading model
+// and thread count (1, 2, 4, ... up to the maximum) every thread spins on
+// a start flag, is released at once into Instance(), and the constructor
+// sleeps for the construction time. Per thread it records:
+//   wait: release until Instance() returned
+//   cpu:  thread CPU time spent inside Instance()
+//   wake: construction finished until Instance() returned (waiters only)
+// and prints the distributions as JSON on stdout.
+//
+// Usage: singleton_stress [max_threads (256)] [construct_ms (20)]
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::chrono::milliseconds g_constructTime{ 20 };
+    std::atomic<Clock::rep> g_constructedAt{ 0 };
+    thread_local bool t_constructed = false; // Set on the thread that ran the constructor
+
+    template <typename Tag>
+    struct SlowPayload {
+        SlowPayload() {
+            std::this_thread::sleep_for(g_constructTime);
+            g_constructedAt.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+            t_constructed = true;
+        }
+    };
+
+    double ThreadCpuUs() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+    }
+
+    double UsBetween(Clock::rep from, Clock::rep to) {
+        return std::chrono::duration<double, std::micro>(Clock::duration(to - from)).count();
+    }
+
+    struct Sample {
+        double waitUs;
+        double cpuUs;
+        Clock::rep returnedAt;
+        bool built;
+    };
+
+    template <typename S>
+    std::vector<Sample> RunHerd(unsigned threads) {
+        dp::detail::SingletonAccess<S>::Reset();
+        std::atomic<bool> start{ false };
+        std::atomic<Clock::rep> releasedAt{ 0 };
+        std::vector<Sample> samples(threads);
+        std::vector<std::thread> workers;
+
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                double cpuBegin = ThreadCpuUs();
+                S::Instance();
+                Sample& sample = samples[t];
+                sample.returnedAt = Clock::now().time_since_epoch().count();
+                sample.cpuUs = ThreadCpuUs() - cpuBegin;
+                sample.waitUs = UsBetween(releasedAt.load(std::memory_order_relaxed), sample.returnedAt);
+                sample.built = t_constructed;
+                });
+        }
+
+        g_constructedAt.store(0, std::memory_order_relaxed);
+        releasedAt.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return samples;
+    }
+
+    // Prints {"mean":..,"p50":..,"p90":..,"p99":..,"max":..}
+    void PrintDistribution(const char* name, std::vector<double> values) {
+        std::printf("\"%s\":{", name);
+        if (values.empty()) {
+            std::printf("\"count\":0}");
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        double sum = 0;
+        for (double v : values) {
+            sum += v;
+        }
+        auto at = [&](double q) {
+            return values[std::min(values.size() - 1, static_cast<std::size_t>(q * values.size()))];
+        };
+        std::printf("\"count\":%zu,\"mean\":%.1f,\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f}",
+            values.size(), sum / values.size(), at(0.50), at(0.90), at(0.99), values.back());
+    }
+
+    bool g_firstResult = true;
+
+    template <template <typename> class ThreadingModel>
+    void Run(const char* name, unsigned maxThreads) {
+        // Distinct tag per model so each gets its own singleton
+        struct Tag {};
+        using S = dp::Singleton<SlowPayload<Tag>, dp::CreateUsingNew, dp::NoDestroy, ThreadingModel>;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            std::vector<Sample> samples = RunHerd<S>(threads);
+            Clock::rep constructedAt = g_constructedAt.load(std::memory_order_acquire);
+
+            std::vector<double> wait, cpu, wake;
+            double cpuTotal = 0;
+            for (const Sample& sample : samples) {
+                wait.push_back(sample.waitUs);
+                cpu.push_back(sample.cpuUs);
+                cpuTotal += sample.cpuUs;
+                if (!sample.built) {
+                    wake.push_back(UsBetween(constructedAt, sample.returnedAt));
+                }
+            }
+
+            std::printf("%s\n    {\"model\":\"%s\",\"threads\":%u,\"cpu_us_total\":%.1f,",
+                g_firstResult ? "" : ",", name, threads, cpuTotal);
+            g_firstResult = false;
+            PrintDistribution("wait_us", wait);
+            std::printf(",");
+            PrintDistribution("cpu_us", cpu);
+            std::printf(",");
+            PrintDistribution("wake_us", wake);
+            std::printf("}");
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 256;
+    if (argc > 2) {
+        g_constructTime = std::chrono::milliseconds(std::atoi(argv[2]));
+    }
+    maxThreads = std::max(1u, maxThreads);
+
+    std::printf("{\"construct_ms\":%lld,\"hardware_threads\":%u,\"results\":[",
+        static_cast<long long>(g_constructTime.count()), std::thread::hardware_concurrency());
+    Run<dp::ClassLevelLockable>("ClassLevelLockable", maxThreads);
+    Run<dp::AtomicLockable>("AtomicLockable", maxThreads);
+    Run<dp::SpinParkLockable>("SpinParkLockable", maxThreads);
+    Run<dp::OnceInit>("OnceInit", maxThreads);
+    std::printf("\n]}\n");
+    return 0;
+}
@@ -0,0 +1,281 @@
+#ifndef ACCESS_POLICY_HPP
+#define ACCESS_POLICY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility> // for std::forward
+#include "sync_primitives.hpp"
+
+namespace dp {
+
+    // Access policies hold a singleton's state and guard it after
+    // construction: Read() returns a guard giving const access and Write()
+    // one giving exclusive mutable access, each released when the guard
+    // goes out of scope. Use one as the singleton's T (see Guarded), and
+    // Singleton<...>::Read()/Write() forward to it. Constructor arguments
+    // are forwarded to the guarded value.
+    // Guards cannot be copied or moved; keep them in a local for the
+    // duration of the access.
+
+    // Readers share a std::shared_mutex; writers take it exclusively
+    template <typename U>
+    class SharedMutexAccess {
+    public:
+        class ReadGuard {
+        public:
+            explicit ReadGuard(const SharedMutexAccess& access) : lock_(access.mtx_), value_(&access.value_) {}
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            const U& operator*() const { return *value_; }
+            const U* operator->() const { return value_; }
+
+        private:
+            std::shared_lock<std::shared_mutex> lock_;
+            const U* value_;
+        };
+
+        class WriteGuard {
+        public:
+            explicit WriteGuard(SharedMutexAccess& access) : lock_(access.mtx_), value_(&access.value_) {}
+            WriteGuard(const WriteGuard&) = delete;
+            WriteGuard& operator=(const WriteGuard&) = delete;
+
+            U& operator*() const { return *value_; }
+            U* operator->() const { return value_; }
+
+        private:
+            std::unique_lock<std::shared_mutex> lock_;
+            U* value_;
+        };
+
+        template <typename... Args>
+        explicit SharedMutexAccess(Args&&... args) : value_(std::forward<Args>(args)...) {}
+
+        SharedMutexAccess(const SharedMutexAccess&) = delete;
+        SharedMutexAccess& operator=(const SharedMutexAccess&) = delete;
+
+        ReadGuard Read() const { return ReadGuard(*this); }
+        WriteGuard Write() { return WriteGuard(*this); }
+
+    private:
+        mutable std::shared_mutex mtx_;
+        U value_;
+    };
+
+    // Sequence lock for small trivially copyable values: readers take no
+    // lock and write nothing shared, they copy the value and retry if a
+    // writer published meanwhile, so reads scale with the number of cores.
+    // A ReadGuard holds that consistent snapshot; a WriteGuard holds a
+    // copy that writers (serialized among themselves) edit and that is
+    // published when the guard is destroyed.
+    template <typename U>
+    class SeqLockAccess {
+        static_assert(std::is_trivially_copyable_v<U>,
+            "SeqLockAccess copies the value while it may be written: U must be trivially copyable");
+
+    public:
+        static constexpr std::size_t kMaxSize = 2 * detail::kCacheLineSize;
+        static_assert(sizeof(U) <= kMaxSize,
+            "SeqLockAccess readers copy the whole value on every read: use it for small U only");
+
+        class ReadGuard {
+        public:
+            explicit ReadGuard(const SeqLockAccess& access) : value_(access.Load()) {}
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            const U& operator*() const { return value_; }
+            const U* operator->() const { return &value_; }
+
+        private:
+            U value_;
+        };
+
+        class WriteGuard {
+        public:
+            explicit WriteGuard(SeqLockAccess& access)
+                : access_(access), lock_(access.writer_.value), value_(access.Copy()) {}
+            WriteGuard(const WriteGuard&) = delete;
+            WriteGuard& operator=(const WriteGuard&) = delete;
+            ~WriteGuard() { access_.Publish(value_); }
+
+            U& operator*() { return value_; }
+            U* operator->() { return &value_; }
+
+        private:
+            SeqLockAccess& access_;
+            std::lock_guard<detail::SpinParkMutex> lock_;
+            U value_;
+        };
+
+        template <typename... Args>
+        explicit SeqLockAccess(Args&&... args) {
+            Words words = {};
+            U value(std::forward<Args>(args)...);
+            std::memcpy(words, &value, sizeof(U));
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+
+        SeqLockAccess(const SeqLockAccess&) = delete;
+        SeqLockAccess& operator=(const SeqLockAccess&) = delete;
+
+        ReadGuard Read() const { return ReadGuard(*this); }
+        WriteGuard Write() { return WriteGuard(*this); }
+
+        // Consistent copy of the value
+        U Load() const {
+            Words words = {};
+            for (;;) {
+                std::uint64_t seq = seq_.load(std::memory_order_acquire);
+                if (seq & 1) { // Write in progress
+                    detail::CpuRelax();
+                    continue;
+                }
+                for (std::size_t i = 0; i < kWords; ++i) {
+                    words[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == seq) {
+                    break;
+                }
+            }
+            return FromWords(words);
+        }
+
+        // Replaces the value
+        void Store(const U& value) {
+            std::lock_guard<detail::SpinParkMutex> lock(writer_.value);
+            Publish(value);
+        }
+
+    private:
+        // The value is kept as relaxed atomic words, so a read overlapping
+        // a write is well defined and simply retried
+        static constexpr std::size_t kWords = (sizeof(U) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        using Words = std::uint64_t[kWords];
+
+        static U FromWords(const Words& words) {
+            typename std::aligned_storage<sizeof(U), alignof(U)>::type storage;
+            std::memcpy(&storage, words, sizeof(U));
+            return *std::launder(reinterpret_cast<U*>(&storage));
+        }
+
+        // Caller holds the writer lock, so no word changes underneath
+        U Copy() const {
+            Words words = {};
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            return FromWords(words);
+        }
+
+        // Caller holds the writer lock
+        void Publish(const U& value) {
+            Words words = {};
+            std::memcpy(words, &value, sizeof(U));
+            std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        alignas(detail::kCacheLineSize) std::atomic<std::uint64_t> seq_{ 0 }; // Odd while a write is in progress
+        std::atomic<std::uint64_t> words_[kWords];
+        detail::CacheLinePadded<detail::SpinParkMutex> writer_;
+    };
+
+    // Per-CPU reader-writer lock (brlock): one cache-line-padded
+    // reader-writer word per CPU. A reader takes only its own CPU's, and
+    // only shared, so readers on different cores touch different lines
+    // and readers sharing a slot never exclude one another; a writer
+    // takes all of them, in order. Suits values read constantly and
+    // written rarely. As with std::shared_mutex, a thread must not nest
+    // Read() while a writer may be waiting.
+    template <typename U>
+    class PerCpuRwAccess {
+    public:
+        // Caps the lock array (and the cost of a write) on very large hosts
+        static constexpr std::size_t kMaxSlots = 64;
+
+        class ReadGuard {
+        public:
+            explicit ReadGuard(const PerCpuRwAccess& access)
+                : slot_(access.slots_[detail::CurrentCpu() % access.slotCount_].value), value_(&access.value_) {
+                slot_.lock_shared();
+            }
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            ~ReadGuard() { slot_.unlock_shared(); } // The slot taken, even if the thread migrated
+
+            const U& operator*() const { return *value_; }
+            const U* operator->() const { return value_; }
+
+        private:
+            detail::SharedSpinParkWord& slot_;
+            const U* value_;
+        };
+
+        class WriteGuard {
+        public:
+            explicit WriteGuard(PerCpuRwAccess& access) : access_(access), writer_(access.writer_.value) {
+                for (std::size_t i = 0; i < access_.slotCount_; ++i) {
+                    access_.slots_[i].value.lock();
+                }
+            }
+            WriteGuard(const WriteGuard&) = delete;
+            WriteGuard& operator=(const WriteGuard&) = delete;
+            ~WriteGuard() {
+                for (std::size_t i = access_.slotCount_; i-- > 0;) {
+                    access_.slots_[i].value.unlock();
+                }
+            }
+
+            U& operator*() const { return access_.value_; }
+            U* operator->() const { return &access_.value_; }
+
+        private:
+            PerCpuRwAccess& access_;
+            std::lock_guard<detail::SpinParkMutex> writer_; // Slot words take one writer at a time
+        };
+
+        template <typename... Args>
+        explicit PerCpuRwAccess(Args&&... args)
+            : slotCount_(std::min(detail::CpuCount(), kMaxSlots)),
+              slots_(new detail::CacheLinePadded<detail::SharedSpinParkWord>[slotCount_]),
+              value_(std::forward<Args>(args)...) {}
+
+        PerCpuRwAccess(const PerCpuRwAccess&) = delete;
+        PerCpuRwAccess& operator=(const PerCpuRwAccess&) = delete;
+
+        ReadGuard Read() const { return ReadGuard(*this); }
+        WriteGuard Write() { return WriteGuard(*this); }
+
+    private:
+        const std::size_t slotCount_;
+        const std::unique_ptr<detail::CacheLinePadded<detail::SharedSpinParkWord>[]> slots_;
+        detail::CacheLinePadded<detail::SpinParkMutex> writer_;
+        U value_;
+    };
+
+    // Guarded<Configuration> as the singleton's T makes
+    // Singleton<...>::Read()/Write() available
+    template <typename U, template <typename> class Access = SharedMutexAccess>
+    using Guarded = Access<U>;
+
+} // namespace dp
+
+#endif // ACCESS_POLICY_HPP
@@ -0,0 +1,197 @@
+#ifndef ARENA_POLICY_HPP
+#define ARENA_POLICY_HPP
+
+#include <cstddef>
+#include <memory> // for std::allocator_traits
+#include <mutex>
+#include <new>
+#include <utility> // for std::forward
+#include <vector>
+#include "sync_primitives.hpp"
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+namespace dp {
+
+    namespace detail {
+
+        // Library-owned monotonic arena that singletons are carved from.
+        // Memory comes in large chunks and is never returned, so instances
+        // end up packed next to each other in a few pages.
+        class SingletonArena {
+        public:
+            static constexpr std::size_t kChunkSize = 64 * 1024;
+
+            // Deliberately leaked: instances may outlive static destruction
+            static SingletonArena& Global() {
+                static SingletonArena* arena = new SingletonArena();
+                return *arena;
+            }
+
+            // Caller holds Mutex()
+            void* Allocate(std::size_t size, std::size_t alignment) {
+                std::size_t offset = chunks_.empty() ? 0 : Aligned(chunks_.back() + used_, alignment) - chunks_.back();
+                if (chunks_.empty() || offset + size > chunkSize_) {
+                    chunkSize_ = size + alignment > kChunkSize ? size + alignment : kChunkSize;
+                    chunks_.push_back(static_cast<char*>(::operator new(chunkSize_)));
+                    offset = Aligned(chunks_.back(), alignment) - chunks_.back();
+                }
+                used_ = offset + size;
+                return chunks_.back() + offset;
+            }
+
+            SpinParkMutex& Mutex() {
+                return mtx_;
+            }
+
+        private:
+            static char* Aligned(char* p, std::size_t alignment) {
+                std::size_t address = reinterpret_cast<std::size_t>(p);
+                return p + ((address + alignment - 1) / alignment * alignment - address);
+            }
+
+            SpinParkMutex mtx_;
+            std::vector<char*> chunks_;
+            std::size_t chunkSize_ = 0;
+            std::size_t used_ = 0;
+        };
+
+    } // namespace detail
+
+    // Standard allocator over the singleton arena. Single objects are
+    // recycled through a free list per type, so an instance destroyed and
+    // recreated (e.g. by PhoenixSingleton) reuses its block without
+    // touching the arena; arrays are carved from the arena and not reused.
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            detail::SingletonArena& arena = detail::SingletonArena::Global();
+            std::lock_guard<detail::SpinParkMutex> guard(arena.Mutex());
+            if (n == 1 && FreeList()) {
+                FreeNode* node = FreeList();
+                FreeList() = node->next;
+                return reinterpret_cast<T*>(node);
+            }
+            return static_cast<T*>(arena.Allocate(n * kBlockSize, kBlockAlign));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            if (n != 1) {
+                return;
+            }
+            std::lock_guard<detail::SpinParkMutex> guard(detail::SingletonArena::Global().Mutex());
+            FreeNode* node = reinterpret_cast<FreeNode*>(p);
+            node->next = FreeList();
+            FreeList() = node;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+
+    private:
+        struct FreeNode {
+            FreeNode* next;
+        };
+
+        // Blocks are large and aligned enough to hold a free-list link
+        static constexpr std::size_t kBlockAlign = alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode);
+        static constexpr std::size_t kBlockSize = ((sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)) + kBlockAlign - 1) / kBlockAlign * kBlockAlign;
+
+        // Guarded by the arena mutex
+        static FreeNode*& FreeList() {
+            static FreeNode* head = nullptr;
+            return head;
+        }
+    };
+
+    // Creation policy allocating through a standard allocator, rebound to T;
+    // use as CreateUsingAllocator<Alloc>::Policy. The allocator is default
+    // constructed once per T, so stateful allocators should pick up their
+    // arena or resource in the default constructor.
+    template <typename Alloc>
+    struct CreateUsingAllocator {
+        template <typename T>
+        struct Policy {
+            using Allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+            using Traits = std::allocator_traits<Allocator>;
+
+            template <typename... Args>
+            static T* Create(Args&&... args) {
+                Allocator& allocator = GetAllocator();
+                T* p = Traits::allocate(allocator, 1);
+#if defined(DP_HAS_EXCEPTIONS)
+                try {
+                    Traits::construct(allocator, p, std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    Traits::deallocate(allocator, p, 1);
+                    throw;
+                }
+#else
+                Traits::construct(allocator, p, std::forward<Args>(args)...);
+#endif
+                return p;
+            }
+
+            static void Destroy(T* p) {
+                if (p) {
+                    Allocator& allocator = GetAllocator();
+                    Traits::destroy(allocator, p);
+                    Traits::deallocate(allocator, p, 1);
+                }
+            }
+
+        private:
+            static Allocator& GetAllocator() {
+                static Allocator allocator;
+                return allocator;
+            }
+        };
+    };
+
+    // Policy for creating objects in the library-owned singleton arena
+    template <typename T>
+    using CreateInArena = typename CreateUsingAllocator<ArenaAllocator<T>>::template Policy<T>;
+
+#if defined(__cpp_lib_memory_resource)
+    // Memory resource that PmrAllocator<T, Tag> allocates from. Specialize
+    // Get() for a tag to route those singletons to a specific resource
+    template <typename Tag>
+    struct MemoryResourceFor {
+        static std::pmr::memory_resource* Get() { return std::pmr::get_default_resource(); }
+    };
+
+    // polymorphic_allocator bound at construction to MemoryResourceFor<Tag>
+    template <typename T, typename Tag = void>
+    class PmrAllocator : public std::pmr::polymorphic_allocator<T> {
+    public:
+        PmrAllocator() noexcept : std::pmr::polymorphic_allocator<T>(MemoryResourceFor<Tag>::Get()) {}
+
+        template <typename U>
+        PmrAllocator(const PmrAllocator<U, Tag>& other) noexcept : std::pmr::polymorphic_allocator<T>(other.resource()) {}
+
+        template <typename U>
+        struct rebind {
+            using other = PmrAllocator<U, Tag>;
+        };
+    };
+#endif
+
+} // namespace dp
+
+#endif // ARENA_POLICY_HPP
@@ -0,0 +1,246 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include "sync_primitives.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>       // for waiting on a non-blocking sink
+#include <sys/uio.h>    // for writev
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>         // for _write
+#endif
+
+namespace dp {
+
+    // Logger that hands each message to a background thread instead of
+    // writing it inline. Producers copy the message into a fixed-size
+    // record of a bounded lock-free MPSC ring; the writer thread drains
+    // ready records in batches with one writev() per batch.
+    // Intended to be wrapped in a Singleton: its destructor drains the
+    // ring and joins the writer, so destruction through DefaultLifetime or
+    // PhoenixSingleton loses nothing, and FastExit flushes it via
+    // FlushOnExit() below.
+    class AsyncLogger {
+    public:
+        static constexpr std::size_t kRecordSize = 256;
+        static constexpr std::size_t kCapacity = 1024;   // Records; power of two
+        static constexpr std::size_t kBatch = 64;        // Records per writev()
+
+        // Longest message kept; longer ones are truncated
+        static constexpr std::size_t kMaxMessage = kRecordSize - sizeof(std::size_t) - sizeof(std::uint32_t) - 1;
+
+        // Writes to fd (standard output by default)
+        explicit AsyncLogger(int fd = 1) : fd_(fd), writer_([this]() { Run(); }) {}
+
+        ~AsyncLogger() {
+            stop_.store(true, std::memory_order_seq_cst);
+            Wake();
+            writer_.join();
+        }
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // Queues message followed by a newline. Blocks only while the ring is full.
+        void Log(std::string_view message) noexcept {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            Record* record;
+            for (;;) {
+                record = &ring_[pos & (kCapacity - 1)];
+                std::size_t seq = record->seq.load(std::memory_order_acquire);
+                std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+                if (dif == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (dif < 0) {
+                    // Full: let the writer catch up
+                    Wake();
+                    std::this_thread::yield();
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+                else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::size_t length = std::min(message.size(), kMaxMessage);
+            std::memcpy(record->text, message.data(), length);
+            record->text[length] = '\n';
+            record->length = static_cast<std::uint32_t>(length + 1);
+            record->seq.store(pos + 1, std::memory_order_release);
+
+            // Pairs with the fence in Park(): either we see the writer
+            // asleep, or it sees this record before sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_relaxed)) {
+                Wake();
+            }
+        }
+
+        // Returns once every message queued before the call has been written
+        void Flush() noexcept {
+            std::size_t target = tail_.load(std::memory_order_acquire);
+            while (written_.load(std::memory_order_acquire) < target) {
+                Wake();
+                std::this_thread::yield();
+            }
+        }
+
+        // Messages written so far
+        std::size_t Written() const noexcept {
+            return written_.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct alignas(detail::kCacheLineSize) Record {
+            std::atomic<std::size_t> seq{ 0 };
+            std::uint32_t length = 0;
+            char text[kMaxMessage + 1];
+        };
+
+        static_assert(sizeof(Record) == kRecordSize, "Record must fill exactly kRecordSize bytes");
+        static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+        struct Ring {
+            Record records[kCapacity];
+
+            Ring() {
+                for (std::size_t i = 0; i < kCapacity; ++i) {
+                    records[i].seq.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            Record& operator[](std::size_t i) { return records[i]; }
+        };
+
+        void Wake() noexcept {
+            if (sleeping_.exchange(0, std::memory_order_seq_cst)) {
+                detail::WakeOne(sleeping_);
+            }
+        }
+
+        // Writer thread: drain batches, park when idle, exit once stopped and empty
+        void Run() {
+            for (;;) {
+                if (Drain()) {
+                    continue;
+                }
+                if (stop_.load(std::memory_order_acquire)) {
+                    if (!Drain()) {
+                        return;
+                    }
+                    continue;
+                }
+                Park();
+            }
+        }
+
+        void Park() {
+            sleeping_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Ready(head_) || stop_.load(std::memory_order_relaxed)) {
+                sleeping_.store(0, std::memory_order_relaxed);
+                return;
+            }
+            detail::WaitOnAddress(sleeping_, 1);
+        }
+
+        bool Ready(std::size_t pos) {
+            return ring_[pos & (kCapacity - 1)].seq.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        // Writes up to kBatch ready records; returns whether any were written
+        bool Drain() {
+            std::size_t count = 0;
+            while (count < kBatch && Ready(head_ + count)) {
+                ++count;
+            }
+            if (count == 0) {
+                return false;
+            }
+            Write(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                ring_[(head_ + i) & (kCapacity - 1)].seq.store(head_ + i + kCapacity, std::memory_order_release);
+            }
+            head_ += count;
+            written_.store(head_, std::memory_order_release);
+            return true;
+        }
+
+        void Write(std::size_t count) {
+#if defined(__unix__) || defined(__APPLE__)
+            iovec iov[kBatch];
+            for (std::size_t i = 0; i < count; ++i) {
+                Record& record = ring_[(head_ + i) & (kCapacity - 1)];
+                iov[i].iov_base = record.text;
+                iov[i].iov_len = record.length;
+            }
+            iovec* next = iov;
+            int left = static_cast<int>(count);
+            while (left > 0) {
+                ssize_t n = ::writev(fd_, next, left);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue; // A signal reached the writer thread
+                    }
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        pollfd ready{ fd_, POLLOUT, 0 };
+                        if (::poll(&ready, 1, -1) >= 0 || errno == EINTR) {
+                            continue; // The sink can take more
+                        }
+                    }
+                    return; // Nowhere to report a failing log sink
+                }
+                // Skip what was written, resuming mid-record after a short write
+                while (left > 0 && static_cast<std::size_t>(n) >= next->iov_len) {
+                    n -= static_cast<ssize_t>(next->iov_len);
+                    ++next;
+                    --left;
+                }
+                if (left > 0) {
+                    next->iov_base = static_cast<char*>(next->iov_base) + n;
+                    next->iov_len -= static_cast<std::size_t>(n);
+                }
+            }
+#else
+            // No gather write: coalesce the batch into one buffer
+            char buffer[kBatch * kRecordSize];
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                Record& record = ring_[(head_ + i) & (kCapacity - 1)];
+                std::memcpy(buffer + size, record.text, record.length);
+                size += record.length;
+            }
+            ::_write(fd_, buffer, static_cast<unsigned>(size));
+#endif
+        }
+
+        const int fd_;
+        Ring ring_;
+        alignas(detail::kCacheLineSize) std::atomic<std::size_t> tail_{ 0 };    // Producers
+        alignas(detail::kCacheLineSize) std::atomic<std::size_t> written_{ 0 }; // Writer, read by Flush()
+        std::size_t head_ = 0;                                                  // Writer only
+        alignas(detail::kCacheLineSize) std::atomic<std::uint32_t> sleeping_{ 0 };
+        std::atomic<bool> stop_{ false };
+        std::thread writer_; // Last: starts once everything above is initialized
+    };
+
+    // Lets FastExit<AsyncLogger> drain the ring at exit
+    inline void FlushOnExit(AsyncLogger& logger) {
+        logger.Flush();
+    }
+
+} // namespace dp
+
+#endif // ASYNC_LOGGER_HPP
@@ -0,0 +1,205 @@
+#ifndef CONFIG_TABLE_HPP
+#define CONFIG_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "swappable_singleton.hpp"
+
+namespace dp {
+
+    // Immutable string key/value table for read-mostly configuration.
+    // Keys and values are interned in one contiguous arena and indexed by
+    // a flat open-addressing table (linear probing, load factor <= 1/2),
+    // so Get() allocates nothing and returns views into the arena.
+    class ConfigTable {
+    public:
+        // Collects changes and builds a new table
+        class Builder {
+        public:
+            Builder() = default;
+
+            // Starts from the contents of an existing table
+            explicit Builder(const ConfigTable& from) {
+                from.ForEach([this](std::string_view key, std::string_view value) { Set(key, value); });
+            }
+
+            Builder& Set(std::string_view key, std::string_view value) {
+                entries_[std::string(key)] = std::string(value);
+                return *this;
+            }
+
+            Builder& Erase(std::string_view key) {
+                entries_.erase(std::string(key));
+                return *this;
+            }
+
+            ConfigTable Build() const {
+                return ConfigTable(entries_);
+            }
+
+        private:
+            std::unordered_map<std::string, std::string> entries_;
+        };
+
+        ConfigTable() = default;
+
+        // Value for key, or fallback if absent; points into this table
+        std::string_view Get(std::string_view key, std::string_view fallback = {}) const noexcept {
+            const Slot* slot = Find(key);
+            return slot ? View(slot->valueOffset, slot->valueLength) : fallback;
+        }
+
+        bool Contains(std::string_view key) const noexcept {
+            return Find(key) != nullptr;
+        }
+
+        std::size_t Size() const noexcept {
+            return size_;
+        }
+
+        // Calls f(key, value) for every entry, in table order
+        template <typename F>
+        void ForEach(F&& f) const {
+            for (const Slot& slot : slots_) {
+                if (slot.hash != kEmpty) {
+                    f(View(slot.keyOffset, slot.keyLength), View(slot.valueOffset, slot.valueLength));
+                }
+            }
+        }
+
+    private:
+        static constexpr std::uint64_t kEmpty = 0;
+
+        struct Slot {
+            std::uint64_t hash = kEmpty;
+            std::uint32_t keyOffset = 0;
+            std::uint32_t keyLength = 0;
+            std::uint32_t valueOffset = 0;
+            std::uint32_t valueLength = 0;
+        };
+
+        explicit ConfigTable(const std::unordered_map<std::string, std::string>& entries)
+            : size_(entries.size()) {
+            std::size_t capacity = 8;
+            while (capacity < 2 * entries.size()) {
+                capacity *= 2;
+            }
+            slots_.resize(capacity);
+            mask_ = capacity - 1;
+
+            std::size_t bytes = 0;
+            for (const auto& entry : entries) {
+                bytes += entry.first.size() + entry.second.size();
+            }
+            arena_.reset(new char[bytes ? bytes : 1]);
+
+            std::uint32_t offset = 0;
+            for (const auto& entry : entries) {
+                Slot slot;
+                slot.hash = Hash(entry.first);
+                slot.keyOffset = Intern(entry.first, offset);
+                slot.keyLength = static_cast<std::uint32_t>(entry.first.size());
+                slot.valueOffset = Intern(entry.second, offset);
+                slot.valueLength = static_cast<std::uint32_t>(entry.second.size());
+
+                std::size_t i = slot.hash & mask_;
+                while (slots_[i].hash != kEmpty) {
+                    i = (i + 1) & mask_;
+                }
+                slots_[i] = slot;
+            }
+        }
+
+        // FNV-1a; never returns kEmpty
+        static std::uint64_t Hash(std::string_view key) noexcept {
+            std::uint64_t h = 14695981039346656037ull;
+            for (unsigned char c : key) {
+                h = (h ^ c) * 1099511628211ull;
+            }
+            return h | 1;
+        }
+
+        std::uint32_t Intern(const std::string& s, std::uint32_t& offset) {
+            std::memcpy(arena_.get() + offset, s.data(), s.size());
+            std::uint32_t at = offset;
+            offset += static_cast<std::uint32_t>(s.size());
+            return at;
+        }
+
+        std::string_view View(std::uint32_t offset, std::uint32_t length) const noexcept {
+            return std::string_view(arena_.get() + offset, length);
+        }
+
+        const Slot* Find(std::string_view key) const noexcept {
+            if (slots_.empty()) {
+                return nullptr;
+            }
+            std::uint64_t h = Hash(key);
+            for (std::size_t i = h & mask_;; i = (i + 1) & mask_) {
+                const Slot& slot = slots_[i];
+                if (slot.hash == kEmpty) {
+                    return nullptr;
+                }
+                if (slot.hash == h && View(slot.keyOffset, slot.keyLength) == key) {
+                    return &slot;
+                }
+            }
+        }
+
+        std::vector<Slot> slots_;
+        std::shared_ptr<char[]> arena_;
+        std::size_t mask_ = 0;
+        std::size_t size_ = 0;
+    };
+
+    // Process-wide configuration registry: lock-free reads of an immutable
+    // ConfigTable, with copy-on-write updates published through
+    // SwappableSingleton. Views returned by a snapshot's Get() stay valid
+    // for the lifetime of that snapshot.
+    class ConfigRegistry {
+    public:
+        using Live = SwappableSingleton<ConfigTable>;
+        using Snapshot = Live::Snapshot;
+
+        static Snapshot Read() {
+            return Live::Read();
+        }
+
+        // Applies f(ConfigTable::Builder&) to a copy of the current table
+        // and publishes the result as one new version
+        template <typename F>
+        static void Modify(F&& f) {
+            std::lock_guard<std::mutex> guard(WriterMutex());
+            ConfigTable::Builder builder(*Live::Acquire());
+            f(builder);
+            Live::Publish(std::make_shared<const ConfigTable>(builder.Build()));
+        }
+
+        static void Set(std::string_view key, std::string_view value) {
+            Modify([&](ConfigTable::Builder& builder) { builder.Set(key, value); });
+        }
+
+        static void Replace(ConfigTable table) {
+            std::lock_guard<std::mutex> guard(WriterMutex());
+            Live::Publish(std::make_shared<const ConfigTable>(std::move(table)));
+        }
+
+    private:
+        // Serializes read-modify-publish so concurrent updates are not lost
+        static std::mutex& WriterMutex() {
+            static std::mutex mtx;
+            return mtx;
+        }
+    };
+
+} // namespace dp
+
+#endif // CONFIG_TABLE_HPP
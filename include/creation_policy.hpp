@@ -3,14 +3,26 @@
 
 #include <memory> // for std::unique_ptr, std::shared_ptr
 #include <cstdlib> // for malloc/free
+#include <cstddef> // for std::byte
+#include <new> // for placement new
+#include <type_traits>
+#include <utility> // for std::forward
+#include "platform.hpp"
+#if defined(_MSC_VER)
+#include <malloc.h> // for _aligned_malloc/_aligned_free
+#endif
 
 namespace dp {
 
+    // Creation policies construct T from whatever arguments Create() is
+    // given (none for a plain Instance() call), forwarded unchanged
+
     // Policy for creating objects using new/delete
     template <typename T>
     struct CreateUsingNew {
-        static T* Create() {
-            return new T();
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            return new T(std::forward<Args>(args)...);
         }
 
         static void Destroy(T* p) {
@@ -19,28 +31,68 @@ namespace dp {
     };
 
     // Policy for creating objects using malloc/free
+    // (aligned allocation for over-aligned types)
     template <typename T>
     struct CreateUsingMalloc {
-        static T* Create() {
-            void* memory = std::malloc(sizeof(T));
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            void* memory = Allocate();
             if (!memory) return nullptr;
-            return new(memory) T();
+#if defined(DP_HAS_EXCEPTIONS)
+            try {
+                return new(memory) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                Free(memory);
+                throw;
+            }
+#else
+            return new(memory) T(std::forward<Args>(args)...);
+#endif
         }
 
         static void Destroy(T* p) {
             if (p) {
                 p->~T();
-                std::free(p);
+                Free(p);
+            }
+        }
+
+    private:
+        static constexpr bool kOverAligned = alignof(T) > alignof(std::max_align_t);
+
+        static void* Allocate() {
+            if constexpr (kOverAligned) {
+#if defined(_MSC_VER)
+                return _aligned_malloc(sizeof(T), alignof(T));
+#else
+                // aligned_alloc needs the size to be a multiple of the alignment
+                return std::aligned_alloc(alignof(T), (sizeof(T) + alignof(T) - 1) / alignof(T) * alignof(T));
+#endif
             }
+            else {
+                return std::malloc(sizeof(T));
+            }
+        }
+
+        static void Free(void* memory) {
+#if defined(_MSC_VER)
+            if constexpr (kOverAligned) {
+                _aligned_free(memory);
+                return;
+            }
+#endif
+            std::free(memory);
         }
     };
 
     // Policy for creating objects using std::shared_ptr
     template <typename T>
     struct CreateUsingSharedPtr {
-        static T* Create() {
+        template <typename... Args>
+        static T* Create(Args&&... args) {
             std::shared_ptr<T>& instance = GetSharedPtr();
-            instance = std::make_shared<T>();
+            instance = std::make_shared<T>(std::forward<Args>(args)...);
             return instance.get();
         }
 
@@ -55,6 +107,42 @@ namespace dp {
         }
     };
 
+    // Policy for creating objects in static storage (no heap allocation).
+    // The buffer is zero-initialized, so it lives in .bss with no startup cost.
+    // It is a static of the policy, apart from Singleton's control block, so
+    // it buys no locality with the instance pointer
+    template <typename T>
+    struct CreateStatic {
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            return new(&storage_) T(std::forward<Args>(args)...);
+        }
+
+        static void Destroy(T* p) {
+            if (p) {
+                p->~T();
+            }
+        }
+
+    private:
+        alignas(T) static std::byte storage_[sizeof(T)];
+    };
+
+    // Static buffer definition
+    template <typename T>
+    alignas(T) std::byte CreateStatic<T>::storage_[sizeof(T)];
+
+    // True for creation policies that keep a single instance per type
+    // (so they cannot back several instances of T at once)
+    template <typename Policy>
+    struct HoldsSingleInstance : std::false_type {};
+
+    template <typename T>
+    struct HoldsSingleInstance<CreateUsingSharedPtr<T>> : std::true_type {};
+
+    template <typename T>
+    struct HoldsSingleInstance<CreateStatic<T>> : std::true_type {};
+
     // Set default creation policy
     template <typename T>
     using DefaultCreationPolicy = CreateUsingNew<T>;
@@ -0,0 +1,106 @@
+#ifndef EAGER_SINGLETON_HPP
+#define EAGER_SINGLETON_HPP
+
+#include <cassert>
+#include <cstddef> // for std::byte
+#include <new> // for placement new, std::launder
+#include <type_traits>
+#include <vector>
+#include "lifetime_policy.hpp"
+
+namespace dp {
+
+    // Initialization modes for EagerSingleton
+    struct InitAtStartup {};    // Constructed during static initialization
+    struct InitExplicitly {};   // Constructed by dp::InitializeAll()
+
+    namespace detail {
+
+        // Constructors of InitExplicitly singletons, in registration order
+        inline std::vector<void (*)()>& DeferredInitializers() {
+            static std::vector<void (*)()> initializers;
+            return initializers;
+        }
+
+    } // namespace detail
+
+    // Constructs every InitExplicitly singleton that is not built yet.
+    // Call once from main() before starting other threads.
+    inline void InitializeAll() {
+        for (void (*init)() : detail::DeferredInitializers()) {
+            init();
+        }
+    }
+
+    // Singleton built ahead of first use. Instance() does no check at all:
+    // it returns the address of a static buffer, which is a link-time
+    // constant, so it inlines to a single address computation.
+    // Accessing it before construction (from another static initializer
+    // with InitAtStartup, or before InitializeAll() with InitExplicitly)
+    // is undefined; debug builds assert on it.
+    template
+        <
+        typename T,
+        typename InitMode = InitAtStartup,
+        template <typename> class LifetimePolicy = DefaultLifetimePolicy
+        >
+        class EagerSingleton {
+        public:
+            static T& Instance() noexcept {
+                (void)&initializer_; // Instantiates the initializer
+                assert(constructed_ && "EagerSingleton accessed before construction");
+                return *std::launder(reinterpret_cast<T*>(&storage_));
+            }
+
+        private:
+            // Prevent creation, copying and assignment
+            EagerSingleton();
+            EagerSingleton(const EagerSingleton&);
+            EagerSingleton& operator=(const EagerSingleton&);
+
+            // Runs during static initialization
+            struct Initializer {
+                Initializer() {
+                    if constexpr (std::is_same_v<InitMode, InitExplicitly>) {
+                        detail::DeferredInitializers().push_back(&Construct);
+                    }
+                    else {
+                        Construct();
+                    }
+                }
+            };
+
+            static void Construct() {
+                if (constructed_) {
+                    return;
+                }
+                T* p = ::new (static_cast<void*>(&storage_)) T();
+                constructed_ = true;
+                detail::ScheduleDestruction<LifetimePolicy<T>>(p, &DestroySingleton);
+            }
+
+            static void DestroySingleton() {
+                std::launder(reinterpret_cast<T*>(&storage_))->~T();
+                constructed_ = false;
+            }
+
+            // Static class members
+            alignas(T) static std::byte storage_[sizeof(T)];
+            static bool constructed_;
+            static Initializer initializer_;
+    };
+
+    // Static members initialization
+    template <typename T, typename InitMode, template <typename> class LifetimePolicy>
+    alignas(T) std::byte EagerSingleton<T, InitMode, LifetimePolicy>::storage_[sizeof(T)];
+
+    template <typename T, typename InitMode, template <typename> class LifetimePolicy>
+    bool EagerSingleton<T, InitMode, LifetimePolicy>::constructed_ = false;
+
+    template <typename T, typename InitMode, template <typename> class LifetimePolicy>
+    typename EagerSingleton<T, InitMode, LifetimePolicy>::Initializer
+        EagerSingleton<T, InitMode, LifetimePolicy>::initializer_;
+
+} // namespace dp
+
+#endif // EAGER_SINGLETON_HPP
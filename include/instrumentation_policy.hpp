@@ -0,0 +1,278 @@
+#ifndef INSTRUMENTATION_POLICY_HPP
+#define INSTRUMENTATION_POLICY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib> // for std::free
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h> // for abi::__cxa_demangle
+#define DP_HAS_CXXABI 1
+#endif
+#endif
+
+namespace dp {
+
+    // Policy recording nothing. Every hook is an empty inline function and
+    // Enabled = false compiles the timestamps out, so the default costs nothing
+    template <typename T>
+    struct NoInstrumentation {
+        static constexpr bool Enabled = false;
+
+        static void OnAccess() {}
+        static void OnLockAcquired(std::uint64_t) {}
+        static void OnLostRace() {}
+        static void OnCreated(std::uint64_t) {}
+    };
+
+    namespace detail {
+
+        inline std::uint64_t NowNs() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // Timestamp for Policy's hooks; 0 without touching the clock when disabled
+        template <typename Policy>
+        std::uint64_t TimestampIf() {
+            if constexpr (Policy::Enabled) {
+                return NowNs();
+            }
+            else {
+                return 0;
+            }
+        }
+
+        template <typename Policy>
+        std::uint64_t ElapsedSince(std::uint64_t start) {
+            if constexpr (Policy::Enabled) {
+                return NowNs() - start;
+            }
+            else {
+                (void)start;
+                return 0;
+            }
+        }
+
+    } // namespace detail
+
+    // Counters of one instrumented singleton. Updated with relaxed atomics;
+    // a dump is a consistent-enough snapshot, not an atomic one
+    struct SingletonStats {
+        // Lock wait histogram: bucket i counts waits below 2^(i + kFirstBucketLog2) ns,
+        // the last bucket everything longer
+        static constexpr int kBuckets = 24;
+        static constexpr int kFirstBucketLog2 = 6;
+
+        explicit SingletonStats(std::string n) : name(std::move(n)) {}
+
+        const std::string name;
+        std::atomic<std::uint64_t> constructions{ 0 };
+        std::atomic<std::uint64_t> constructionNs{ 0 };     // Total
+        std::atomic<std::uint64_t> lastConstructionNs{ 0 };
+        std::atomic<std::uint64_t> lockAcquisitions{ 0 };   // Slow-path entries
+        std::atomic<std::uint64_t> lockWaitNs{ 0 };         // Total
+        std::atomic<std::uint64_t> lostRaces{ 0 };          // Found the instance already built under the lock
+        std::atomic<std::uint64_t> accesses{ 0 };           // Sampled estimate
+        std::atomic<std::uint64_t> lockWaitHistogram[kBuckets] = {};
+
+        static int BucketOf(std::uint64_t ns) {
+            int bucket = 0;
+            for (std::uint64_t bound = std::uint64_t(1) << kFirstBucketLog2; ns >= bound && bucket < kBuckets - 1; bound <<= 1) {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        // Upper bound of bucket i in nanoseconds (the last one is unbounded)
+        static std::uint64_t BucketBound(int bucket) {
+            return std::uint64_t(1) << (bucket + kFirstBucketLog2);
+        }
+    };
+
+    // Every instrumented singleton's stats, dumpable as JSON or in the
+    // Prometheus text exposition format
+    class InstrumentationRegistry {
+    public:
+        // Deliberately leaked: singletons may be instrumented during static destruction
+        static InstrumentationRegistry& Global() {
+            static InstrumentationRegistry* registry = new InstrumentationRegistry();
+            return *registry;
+        }
+
+        SingletonStats& Add(std::string name) {
+            std::lock_guard<std::mutex> guard(mtx_);
+            stats_.push_back(std::make_unique<SingletonStats>(std::move(name)));
+            return *stats_.back();
+        }
+
+        // Calls f(const SingletonStats&) for every registered singleton
+        template <typename F>
+        void ForEach(F&& f) const {
+            std::lock_guard<std::mutex> guard(mtx_);
+            for (const auto& stats : stats_) {
+                f(*stats);
+            }
+        }
+
+        void WriteJson(std::ostream& out) const {
+            out << "{\"singletons\":[";
+            bool first = true;
+            ForEach([&](const SingletonStats& s) {
+                out << (first ? "" : ",") << "{\"name\":\"" << Escaped(s.name);
+                first = false;
+                out << "\",\"constructions\":" << Load(s.constructions)
+                    << ",\"construction_ns_total\":" << Load(s.constructionNs)
+                    << ",\"construction_ns_last\":" << Load(s.lastConstructionNs)
+                    << ",\"lock_acquisitions\":" << Load(s.lockAcquisitions)
+                    << ",\"lock_wait_ns_total\":" << Load(s.lockWaitNs)
+                    << ",\"lost_races\":" << Load(s.lostRaces)
+                    << ",\"accesses_sampled\":" << Load(s.accesses)
+                    << ",\"lock_wait_histogram\":[";
+                for (int i = 0; i < SingletonStats::kBuckets; ++i) {
+                    out << (i ? "," : "") << "{\"le_ns\":";
+                    if (i == SingletonStats::kBuckets - 1) {
+                        out << "null";
+                    }
+                    else {
+                        out << SingletonStats::BucketBound(i);
+                    }
+                    out << ",\"count\":" << Load(s.lockWaitHistogram[i]) << "}";
+                }
+                out << "]}";
+                });
+            out << "]}";
+        }
+
+        void WritePrometheus(std::ostream& out) const {
+            out << "# TYPE dp_singleton_constructions_total counter\n"
+                << "# TYPE dp_singleton_construction_seconds_total counter\n"
+                << "# TYPE dp_singleton_lost_races_total counter\n"
+                << "# TYPE dp_singleton_accesses_total counter\n"
+                << "# TYPE dp_singleton_lock_wait_seconds histogram\n";
+            ForEach([&](const SingletonStats& s) {
+                std::string label = "{singleton=\"" + Escaped(s.name) + "\"";
+                out << "dp_singleton_constructions_total" << label << "} " << Load(s.constructions) << "\n"
+                    << "dp_singleton_construction_seconds_total" << label << "} " << Seconds(Load(s.constructionNs)) << "\n"
+                    << "dp_singleton_lost_races_total" << label << "} " << Load(s.lostRaces) << "\n"
+                    << "dp_singleton_accesses_total" << label << "} " << Load(s.accesses) << "\n";
+                std::uint64_t cumulative = 0;
+                for (int i = 0; i < SingletonStats::kBuckets; ++i) {
+                    cumulative += Load(s.lockWaitHistogram[i]);
+                    out << "dp_singleton_lock_wait_seconds_bucket" << label << ",le=\"";
+                    if (i == SingletonStats::kBuckets - 1) {
+                        out << "+Inf";
+                    }
+                    else {
+                        out << Seconds(SingletonStats::BucketBound(i));
+                    }
+                    out << "\"} " << cumulative << "\n";
+                }
+                out << "dp_singleton_lock_wait_seconds_sum" << label << "} " << Seconds(Load(s.lockWaitNs)) << "\n"
+                    << "dp_singleton_lock_wait_seconds_count" << label << "} " << cumulative << "\n";
+                });
+        }
+
+    private:
+        static std::uint64_t Load(const std::atomic<std::uint64_t>& counter) {
+            return counter.load(std::memory_order_relaxed);
+        }
+
+        static double Seconds(std::uint64_t ns) {
+            return static_cast<double>(ns) / 1e9;
+        }
+
+        // Escapes backslash, quote and newline (valid for JSON strings and Prometheus labels)
+        static std::string Escaped(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '\\' || c == '"') {
+                    out += '\\';
+                    out += c;
+                }
+                else if (c == '\n') {
+                    out += "\\n";
+                }
+                else {
+                    out += c;
+                }
+            }
+            return out;
+        }
+
+        mutable std::mutex mtx_;
+        std::vector<std::unique_ptr<SingletonStats>> stats_;
+    };
+
+    // Name an instrumented singleton is registered under; the demangled
+    // type name by default. Specialize Get() for a shorter one
+    template <typename T>
+    struct InstrumentationName {
+        static std::string Get() {
+            const char* mangled = typeid(T).name();
+#if defined(DP_HAS_CXXABI)
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+            if (status == 0 && demangled) {
+                std::string name(demangled);
+                std::free(demangled);
+                return name;
+            }
+#endif
+            return mangled;
+        }
+    };
+
+    // Policy recording construction time, lock waits on the creation slow
+    // path, threads that lost the creation race and a sampled access count
+    // into InstrumentationRegistry::Global(). Accesses are counted per
+    // thread and published every kSampleRate calls, so the fast path
+    // touches no shared cache line.
+    template <typename T>
+    struct Instrumented {
+        static constexpr bool Enabled = true;
+        static constexpr std::uint32_t kSampleRate = 64; // Power of two
+
+        static void OnAccess() {
+            static thread_local std::uint32_t calls = 0;
+            if ((++calls & (kSampleRate - 1)) == 0) {
+                Stats().accesses.fetch_add(kSampleRate, std::memory_order_relaxed);
+            }
+        }
+
+        static void OnLockAcquired(std::uint64_t waitNs) {
+            SingletonStats& stats = Stats();
+            stats.lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            stats.lockWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+            stats.lockWaitHistogram[SingletonStats::BucketOf(waitNs)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void OnLostRace() {
+            Stats().lostRaces.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void OnCreated(std::uint64_t ns) {
+            SingletonStats& stats = Stats();
+            stats.constructions.fetch_add(1, std::memory_order_relaxed);
+            stats.constructionNs.fetch_add(ns, std::memory_order_relaxed);
+            stats.lastConstructionNs.store(ns, std::memory_order_relaxed);
+        }
+
+        static SingletonStats& Stats() {
+            static SingletonStats& stats = InstrumentationRegistry::Global().Add(InstrumentationName<T>::Get());
+            return stats;
+        }
+    };
+
+} // namespace dp
+
+#endif // INSTRUMENTATION_POLICY_HPP
@@ -3,9 +3,121 @@
 
 #include <stdexcept>
 #include <cstdlib> // for atexit
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "platform.hpp"
+#include "policy_traits.hpp"
+#include "sync_primitives.hpp"
 
 namespace dp {
 
+    namespace detail {
+
+        // Central destruction list: one atexit handler, entries destroyed in
+        // increasing longevity, LIFO among equal longevities
+        class LifetimeTracker {
+        public:
+            using DestroyFn = void (*)();
+
+            // Process-wide tracker; deliberately leaked so it outlives every singleton
+            static LifetimeTracker& Global() {
+                static LifetimeTracker* tracker = new LifetimeTracker(true);
+                return *tracker;
+            }
+
+            explicit LifetimeTracker(bool registerAtExit = false)
+                : registerAtExit_(registerAtExit) {}
+
+            void Add(unsigned int longevity, DestroyFn pFun) {
+                std::lock_guard<std::mutex> guard(mtx_);
+                if (registerAtExit_) {
+                    std::atexit(&DestroyGlobal);
+                    registerAtExit_ = false;
+                }
+                // Sorted by decreasing longevity; the back is destroyed first
+                auto pos = std::upper_bound(entries_.begin(), entries_.end(), longevity,
+                    [](unsigned int l, const Entry& e) { return l > e.longevity; });
+                entries_.insert(pos, Entry{ longevity, pFun });
+            }
+
+            // Destroys same-longevity entries concurrently when enabled
+            void SetParallel(bool enabled) {
+                parallel_.store(enabled, std::memory_order_relaxed);
+            }
+
+            // Destroys everything, including entries added while running
+            void DestroyAll() {
+                for (;;) {
+                    std::vector<DestroyFn> batch;
+                    {
+                        std::lock_guard<std::mutex> guard(mtx_);
+                        if (entries_.empty()) {
+                            return;
+                        }
+                        unsigned int longevity = entries_.back().longevity;
+                        while (!entries_.empty() && entries_.back().longevity == longevity) {
+                            batch.push_back(entries_.back().pFun);
+                            entries_.pop_back();
+                        }
+                    }
+                    if (batch.size() > 1 && parallel_.load(std::memory_order_relaxed)) {
+                        std::vector<std::thread> workers;
+                        MarkMultithreaded();
+                        for (std::size_t i = 1; i < batch.size(); ++i) {
+                            workers.emplace_back(batch[i]);
+                        }
+                        batch.front()();
+                        for (auto& worker : workers) {
+                            worker.join();
+                        }
+                    }
+                    else {
+                        for (DestroyFn pFun : batch) {
+                            pFun();
+                        }
+                    }
+                }
+            }
+
+        private:
+            struct Entry {
+                unsigned int longevity;
+                DestroyFn pFun;
+            };
+
+            static void DestroyGlobal() {
+                Global().DestroyAll();
+            }
+
+            std::vector<Entry> entries_;
+            std::mutex mtx_;
+            std::atomic<bool> parallel_{ false };
+            bool registerAtExit_;
+        };
+
+        // Calls whichever ScheduleDestruction signature the policy provides
+        template <typename Policy, typename T>
+        void ScheduleDestruction(T* pObj, void (*pFun)()) {
+            if constexpr (TakesInstance<Policy, T>::value) {
+                Policy::ScheduleDestruction(pObj, pFun);
+            }
+            else {
+                Policy::ScheduleDestruction(pFun);
+            }
+        }
+
+    } // namespace detail
+
+    // Lets singletons with equal longevity be destroyed concurrently at exit
+    inline void SetParallelDestruction(bool enabled) {
+        detail::LifetimeTracker::Global().SetParallel(enabled);
+    }
+
     // Policy with standard lifetime (destroyed at program exit)
     template <typename T>
     class DefaultLifetime {
@@ -15,7 +127,7 @@ namespace dp {
         }
 
         static void OnDeadReference() {
-            throw std::logic_error("Dead reference to singleton detected");
+            detail::Raise<std::logic_error>("Dead reference to singleton detected");
         }
     };
 
@@ -23,6 +135,8 @@ namespace dp {
     template <typename T>
     class NoDestroy {
     public:
+        static constexpr bool DestroysInstance = false;
+
         static void ScheduleDestruction(void (*pFun)()) {
             // Do nothing
         }
@@ -32,10 +146,67 @@ namespace dp {
         }
     };
 
+    // Opts FastExit<T> into flushing at std::quick_exit as well as at exit;
+    // specialize value to true for T. Off by default: quick_exit handlers
+    // run in whatever state the process is in when it bails out
+    template <typename T>
+    struct FlushOnQuickExit {
+        static constexpr bool value = false;
+    };
+
+    // Policy that never runs the destructor or frees the memory at exit,
+    // but still gives a deterministic flush point: an ADL-visible
+    // `void FlushOnExit(T&)` is called from atexit and, for T opted in via
+    // FlushOnQuickExit<T>, from at_quick_exit where available.
+    // It flushes a single instance of T: scheduling a second one is an error
+    template <typename T>
+    class FastExit {
+    public:
+        static constexpr bool DestroysInstance = false;
+
+        static void ScheduleDestruction(T* pObj, void (*)()) {
+            if (Target() && Target() != pObj) {
+                detail::Raise<std::logic_error>("FastExit flushes one instance of T: another is already scheduled");
+            }
+            Target() = pObj;
+            static const bool registered = Register();
+            (void)registered;
+        }
+
+        static void OnDeadReference() {
+            // Never destroyed, so never dead
+        }
+
+        // Flushes the instance now; also what runs at exit
+        static void FlushNow() {
+            if (T* p = Target()) {
+                FlushOnExit(*p);
+            }
+        }
+
+    private:
+        static T*& Target() {
+            static T* target = nullptr;
+            return target;
+        }
+
+        static bool Register() {
+            std::atexit(&FlushNow);
+#if !defined(__APPLE__)
+            if constexpr (FlushOnQuickExit<T>::value) {
+                std::at_quick_exit(&FlushNow);
+            }
+#endif
+            return true;
+        }
+    };
+
     // Policy that recreates the singleton when accessed after destruction
     template <typename T>
     class PhoenixSingleton {
     public:
+        static constexpr bool SupportsPerThreadInstances = true;
+
         static void ScheduleDestruction(void (*pFun)()) {
             std::atexit(pFun);
         }
@@ -45,6 +216,92 @@ namespace dp {
         }
     };
 
+    // Policy for per-thread threading models (ThreadLocalSingleton,
+    // RecycledThreadLocal), which destroy or recycle each thread's
+    // instance when the thread exits; nothing is scheduled at process
+    // exit. An access after that (e.g. from a later thread_local
+    // destructor) recreates the instance
+    template <typename T>
+    class DestroyAtThreadExit {
+    public:
+        static constexpr bool SupportsPerThreadInstances = true;
+
+        static void ScheduleDestruction(void (*)()) {
+            // The threading model destroys the instance
+        }
+
+        static void OnDeadReference() {
+            // Allow recreation
+        }
+    };
+
+    // Policy that destroys singletons in longevity order from a single
+    // atexit handler. Lower longevity is destroyed first. Longevity is
+    // looked up through an ADL-visible `unsigned int GetLongevity(T*)`
+    template <typename T>
+    class SingletonWithLongevity {
+    public:
+        static void ScheduleDestruction(T* pObj, void (*pFun)()) {
+            detail::LifetimeTracker::Global().Add(GetLongevity(pObj), pFun);
+        }
+
+        static void OnDeadReference() {
+            detail::Raise<std::logic_error>("Dead reference to singleton detected");
+        }
+    };
+
+    // Dead-reference policies: destroyed at program exit like
+    // DefaultLifetime, but never throw on access after destruction, so
+    // they suit builds without exceptions. The check sits on Singleton's
+    // out-of-line creation path and costs the fast path nothing.
+
+    // Prints a diagnostic naming T and aborts
+    template <typename T>
+    class AbortOnDeadReference {
+    public:
+        static void ScheduleDestruction(void (*pFun)()) {
+            std::atexit(pFun);
+        }
+
+        static void OnDeadReference() {
+            detail::Fail("Dead reference to singleton detected", DP_FUNCTION);
+        }
+    };
+
+    // Hands out a default-constructed fallback instance, built on first
+    // dead access and never destroyed; the destroyed instance is not
+    // recreated. Singleton only
+    template <typename T>
+    class FallbackOnDeadReference {
+    public:
+        static void ScheduleDestruction(void (*pFun)()) {
+            std::atexit(pFun);
+        }
+
+        static T* OnDeadReference() {
+            static T* fallback = new T();
+            return fallback;
+        }
+    };
+
+    // Calls Handler (e.g. to log or abort); if it returns, the instance
+    // is recreated as with PhoenixSingleton. Use as
+    // NotifyOnDeadReference<&OnDead>::Policy
+    template <void (*Handler)()>
+    struct NotifyOnDeadReference {
+        template <typename T>
+        class Policy {
+        public:
+            static void ScheduleDestruction(void (*pFun)()) {
+                std::atexit(pFun);
+            }
+
+            static void OnDeadReference() {
+                Handler();
+            }
+        };
+    };
+
     // Set default lifetime policy
     template <typename T>
     using DefaultLifetimePolicy = DefaultLifetime<T>;
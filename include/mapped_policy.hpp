@@ -0,0 +1,296 @@
+#ifndef MAPPED_POLICY_HPP
+#define MAPPED_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new> // for placement new
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility> // for std::forward
+#include "creation_policy.hpp"
+#include "platform.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h> // for flock
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DP_HAS_MAPPED_IMAGES 1
+#endif
+
+namespace dp {
+
+    // Pointer stored as a distance from itself, so it stays valid when the
+    // object holding it is mapped at a different address (e.g. a
+    // CreateMapped image attached by another process). Only point at
+    // memory inside the same image; a null pointer is stored as 0.
+    template <typename U>
+    class OffsetPtr {
+    public:
+        OffsetPtr(U* p = nullptr) noexcept { Set(p); }
+        OffsetPtr(const OffsetPtr& other) noexcept { Set(other.get()); }
+
+        OffsetPtr& operator=(const OffsetPtr& other) noexcept {
+            Set(other.get());
+            return *this;
+        }
+
+        OffsetPtr& operator=(U* p) noexcept {
+            Set(p);
+            return *this;
+        }
+
+        U* get() const noexcept {
+            return offset_ ? reinterpret_cast<U*>(reinterpret_cast<std::intptr_t>(this) + offset_) : nullptr;
+        }
+
+        U* operator->() const noexcept { return get(); }
+        U& operator*() const noexcept { return *get(); }
+        U& operator[](std::ptrdiff_t i) const noexcept { return get()[i]; }
+        explicit operator bool() const noexcept { return offset_ != 0; }
+
+    private:
+        void Set(U* p) noexcept {
+            offset_ = p ? reinterpret_cast<std::intptr_t>(p) - reinterpret_cast<std::intptr_t>(this) : 0;
+        }
+
+        std::intptr_t offset_ = 0;
+    };
+
+    // Backing file and version of a CreateMapped<T> image. Specialize it
+    // for T; with the default empty path CreateMapped builds on the heap.
+    // Bump Version() whenever the image contents would change
+    template <typename T>
+    struct MappedImageOf {
+        static std::string Path() { return std::string(); }
+        static std::uint32_t Version() { return 1; }
+    };
+
+    namespace detail {
+
+        // Header in front of T in the image file. The image is accepted
+        // only if every field matches what this build would write
+        struct MappedImageHeader {
+            static constexpr char kMagic[8] = { 'd', 'p', 'i', 'm', 'a', 'g', 'e', '1' };
+
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t complete;  // Set after T is fully constructed
+            std::uint64_t size;      // sizeof(T)
+            std::uint64_t alignment; // alignof(T)
+            std::uint64_t typeHash;  // FNV-1a of typeid(T).name()
+        };
+
+        inline std::uint64_t TypeNameHash(const char* name) {
+            std::uint64_t h = 14695981039346656037ull;
+            for (; *name; ++name) {
+                h = (h ^ static_cast<unsigned char>(*name)) * 1099511628211ull;
+            }
+            return h;
+        }
+
+    } // namespace detail
+
+    // Policy placing T in a file-backed mapping so a restarted (or
+    // sibling) process attaches to the already-built image instead of
+    // constructing T again. The first process builds the image into a
+    // temporary file under an exclusive lock on "<path>.lock" and renames
+    // it into place, so readers only ever see complete images. Images are
+    // mapped copy-on-write: pages are shared between processes until
+    // written, and writes stay private to the process.
+    // T is stored bit for bit, so it must not hold absolute pointers (use
+    // OffsetPtr) or own heap memory. A missing, stale or foreign image is
+    // rebuilt; without a path or mmap the instance is built on the heap.
+    // Constructor arguments are only used when the image is built.
+    template <typename T>
+    struct CreateMapped {
+        static_assert(std::is_trivially_destructible_v<T>,
+            "CreateMapped images are unmapped, never destroyed: T must be trivially destructible");
+
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            State& state = GetState();
+            state.attached = false;
+#if defined(DP_HAS_MAPPED_IMAGES)
+            std::string path = MappedImageOf<T>::Path();
+            if (!path.empty()) {
+                if (T* p = Attach(path)) {
+                    return p;
+                }
+                // Serialize builders so concurrent starts construct T once
+                int lock = ::open((path + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if (lock >= 0) {
+                    ::flock(lock, LOCK_EX);
+                }
+                T* p = Attach(path);
+#if defined(DP_HAS_EXCEPTIONS)
+                try {
+                    if (!p) {
+                        p = Build(path, std::forward<Args>(args)...);
+                    }
+                }
+                catch (...) {
+                    if (lock >= 0) {
+                        ::close(lock); // Releases the flock
+                    }
+                    throw;
+                }
+#else
+                if (!p) {
+                    p = Build(path, std::forward<Args>(args)...);
+                }
+#endif
+                if (lock >= 0) {
+                    ::close(lock);
+                }
+                if (p) {
+                    return p;
+                }
+            }
+#endif
+            state.base = nullptr;
+            return new T(std::forward<Args>(args)...);
+        }
+
+        static void Destroy(T* p) {
+            if (!p) {
+                return;
+            }
+            State& state = GetState();
+#if defined(DP_HAS_MAPPED_IMAGES)
+            if (state.base) {
+                ::munmap(state.base, kImageSize);
+                state.base = nullptr;
+                return;
+            }
+#endif
+            delete p;
+        }
+
+        // Whether the current instance came from an existing image
+        static bool Attached() {
+            return GetState().attached;
+        }
+
+    private:
+        struct State {
+            void* base = nullptr; // Mapping holding the instance, null for the heap
+            bool attached = false;
+        };
+
+        static State& GetState() {
+            static State state;
+            return state;
+        }
+
+        // T follows the header at an offset aligned for T
+        static constexpr std::size_t kDataOffset =
+            (sizeof(detail::MappedImageHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+        static constexpr std::size_t kImageSize = kDataOffset + sizeof(T);
+
+        static detail::MappedImageHeader ExpectedHeader() {
+            detail::MappedImageHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, detail::MappedImageHeader::kMagic, sizeof(header.magic));
+            header.version = MappedImageOf<T>::Version();
+            header.complete = 1;
+            header.size = sizeof(T);
+            header.alignment = alignof(T);
+            header.typeHash = detail::TypeNameHash(typeid(T).name());
+            return header;
+        }
+
+#if defined(DP_HAS_MAPPED_IMAGES)
+        static T* Publish(void* base, bool attached) {
+            State& state = GetState();
+            state.base = base;
+            state.attached = attached;
+            return std::launder(reinterpret_cast<T*>(static_cast<char*>(base) + kDataOffset));
+        }
+
+        // Maps a valid existing image, or returns nullptr
+        static T* Attach(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return nullptr;
+            }
+            struct stat info;
+            void* base = MAP_FAILED;
+            if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) == kImageSize) {
+                base = ::mmap(nullptr, kImageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (base == MAP_FAILED) {
+                return nullptr;
+            }
+            detail::MappedImageHeader expected = ExpectedHeader();
+            if (std::memcmp(base, &expected, sizeof(expected)) != 0) {
+                ::munmap(base, kImageSize);
+                return nullptr;
+            }
+            return Publish(base, true);
+        }
+
+        // Constructs T into a fresh image and renames it over path; the
+        // instance stays mapped from the new file. Returns nullptr (after
+        // cleaning up) if any file operation fails
+        template <typename... Args>
+        static T* Build(const std::string& path, Args&&... args) {
+            std::string temporary = path + ".tmp." + std::to_string(::getpid());
+            int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return nullptr;
+            }
+            void* image = MAP_FAILED;
+            if (::ftruncate(fd, static_cast<off_t>(kImageSize)) == 0) {
+                image = ::mmap(nullptr, kImageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            if (image == MAP_FAILED) {
+                ::close(fd);
+                ::unlink(temporary.c_str());
+                return nullptr;
+            }
+
+            detail::MappedImageHeader header = ExpectedHeader();
+            header.complete = 0;
+            std::memcpy(image, &header, sizeof(header));
+#if defined(DP_HAS_EXCEPTIONS)
+            try {
+                new(static_cast<char*>(image) + kDataOffset) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                ::munmap(image, kImageSize);
+                ::close(fd);
+                ::unlink(temporary.c_str());
+                throw;
+            }
+#else
+            new(static_cast<char*>(image) + kDataOffset) T(std::forward<Args>(args)...);
+#endif
+            static_cast<detail::MappedImageHeader*>(image)->complete = 1;
+            ::munmap(image, kImageSize);
+
+            // Remap copy-on-write, like attached images
+            void* base = ::mmap(nullptr, kImageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (base == MAP_FAILED || ::rename(temporary.c_str(), path.c_str()) != 0) {
+                if (base != MAP_FAILED) {
+                    ::munmap(base, kImageSize);
+                }
+                ::unlink(temporary.c_str());
+                return nullptr;
+            }
+            return Publish(base, false);
+        }
+#endif
+    };
+
+    template <typename T>
+    struct HoldsSingleInstance<CreateMapped<T>> : std::true_type {};
+
+} // namespace dp
+
+#endif // MAPPED_POLICY_HPP
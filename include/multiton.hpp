@@ -0,0 +1,376 @@
+#ifndef MULTITON_HPP
+#define MULTITON_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // for std::hash
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "creation_policy.hpp"
+#include "lifetime_policy.hpp"
+#include "threading_policy.hpp"
+#include "policy_traits.hpp"
+#include "sync_primitives.hpp"
+
+namespace dp {
+
+    namespace detail {
+
+        template <typename S>
+        struct SingletonAccess;
+
+        // Per-key instance slot shared by Multiton and DenseMultiton
+        template <typename T>
+        struct MultitonInstance {
+            std::atomic<T*> instance{ nullptr };
+            OnceFlag once;
+            bool destroyed = false; // Only accessed inside once or at destruction
+        };
+
+    } // namespace detail
+
+    // Keyed singleton: one instance of T per Key, created on first use
+    // through CreationPolicy and destroyed together as LifetimePolicy
+    // schedules. Keys live in an open-addressing table that only grows
+    // (by chaining doubled tables), so looking up an existing key is a
+    // bounded sequence of acquire loads with no lock. New keys are added
+    // under ThreadingModel<T>::Lock, held only to publish the key; each
+    // instance is built once via its own once-flag, so a slow constructor
+    // delays only callers of that key.
+    template
+        <
+        typename Key,
+        typename T,
+        template <typename> class CreationPolicy = DefaultCreationPolicy,
+        template <typename> class LifetimePolicy = DefaultLifetimePolicy,
+        template <typename> class ThreadingModel = DefaultThreadingModel,
+        typename Hash = std::hash<Key>
+        >
+        class Multiton {
+        private:
+            static_assert(!HoldsSingleInstance<CreationPolicy<T>>::value,
+                "Multiton needs a creation policy that can create several instances");
+            static_assert(!OwnsInstanceStorage<ThreadingModel<T>>::value,
+                "Multiton needs a threading model with a real Lock");
+            static_assert(!ProvidesFallbackInstance<LifetimePolicy<T>, T>::value,
+                "Multiton recreates destroyed instances: it cannot hand out a fallback instance");
+            static_assert(!SchedulesOneInstance<LifetimePolicy<T>, T>::value,
+                "Multiton schedules all its instances together: it cannot use a lifetime policy that takes one instance (FastExit, SingletonWithLongevity)");
+
+            static constexpr bool kTracksDestruction = DestroysInstance<LifetimePolicy<T>>::value;
+
+        public:
+            // Instance for key, constructed from args on first use of that key
+            template <typename... Args>
+            static T& Instance(const Key& key, Args&&... args) {
+                Entry* entry = Lookup(key, HashOf(key));
+                if (entry) {
+                    if (T* p = entry->slot.instance.load(std::memory_order_acquire)) {
+                        return *p;
+                    }
+                }
+                else {
+                    entry = Insert(key);
+                }
+                return *MakeInstance(*entry, std::forward<Args>(args)...);
+            }
+
+            // Instance for key, or nullptr if it does not exist; never creates
+            static T* Find(const Key& key) {
+                Entry* entry = Lookup(key, HashOf(key));
+                return entry ? entry->slot.instance.load(std::memory_order_acquire) : nullptr;
+            }
+
+            // Calls f(key, instance) for every live instance
+            template <typename F>
+            static void ForEach(F&& f) {
+                ForEachEntry([&](Entry& entry) {
+                    if (T* p = entry.slot.instance.load(std::memory_order_acquire)) {
+                        f(entry.key, *p);
+                    }
+                    });
+            }
+
+        private:
+            template <typename>
+            friend struct detail::SingletonAccess;
+
+            // Prevent creation, copying and assignment
+            Multiton();
+            Multiton(const Multiton&);
+            Multiton& operator=(const Multiton&);
+
+            struct Entry {
+                explicit Entry(const Key& k) : key(k) {}
+
+                const Key key;
+                detail::MultitonInstance<T> slot;
+            };
+
+            struct Slot {
+                std::atomic<std::size_t> hash{ 0 };
+                std::atomic<Entry*> entry{ nullptr };
+            };
+
+            // Fixed-capacity table; when full (load factor 1/2) a table of
+            // twice the capacity is chained behind it. Tables and entries
+            // are never freed, so readers need no protection
+            struct Table {
+                explicit Table(std::size_t capacity) : mask(capacity - 1), slots(new Slot[capacity]) {}
+
+                const std::size_t mask;
+                std::size_t count = 0; // Writer only
+                std::unique_ptr<Slot[]> slots;
+                std::atomic<Table*> next{ nullptr };
+            };
+
+            static constexpr std::size_t kInitialCapacity = 16;
+
+            // Spreads identity hashes (e.g. of integers) over the table
+            static std::size_t HashOf(const Key& key) {
+                std::uint64_t h = static_cast<std::uint64_t>(Hash{}(key));
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdull;
+                h ^= h >> 33;
+                return static_cast<std::size_t>(h);
+            }
+
+            static Table* Head() {
+                static Table* head = new Table(kInitialCapacity);
+                return head;
+            }
+
+            static Entry* Lookup(const Key& key, std::size_t h) {
+                for (Table* t = Head(); t; t = t->next.load(std::memory_order_acquire)) {
+                    for (std::size_t i = h & t->mask, n = 0; n <= t->mask; i = (i + 1) & t->mask, ++n) {
+                        Slot& slot = t->slots[i];
+                        Entry* entry = slot.entry.load(std::memory_order_acquire);
+                        if (!entry) {
+                            break;
+                        }
+                        if (slot.hash.load(std::memory_order_relaxed) == h && entry->key == key) {
+                            return entry;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+
+            // Adds key (if another thread has not) under the lock
+            static Entry* Insert(const Key& key) {
+                std::size_t h = HashOf(key);
+                typename ThreadingModel<T>::Lock guard;
+                if (Entry* existing = Lookup(key, h)) {
+                    return existing;
+                }
+                Table* t = Head();
+                while (Table* next = t->next.load(std::memory_order_relaxed)) {
+                    t = next;
+                }
+                if (2 * (t->count + 1) > t->mask + 1) {
+                    Table* bigger = new Table(2 * (t->mask + 1));
+                    t->next.store(bigger, std::memory_order_release);
+                    t = bigger;
+                }
+                std::size_t i = h & t->mask;
+                while (t->slots[i].entry.load(std::memory_order_relaxed)) {
+                    i = (i + 1) & t->mask;
+                }
+                Entry* entry = new Entry(key);
+                t->slots[i].hash.store(h, std::memory_order_relaxed);
+                t->slots[i].entry.store(entry, std::memory_order_release);
+                ++t->count;
+                return entry;
+            }
+
+            template <typename F>
+            static void ForEachEntry(F&& f) {
+                for (Table* t = Head(); t; t = t->next.load(std::memory_order_acquire)) {
+                    for (std::size_t i = 0; i <= t->mask; ++i) {
+                        if (Entry* entry = t->slots[i].entry.load(std::memory_order_acquire)) {
+                            f(*entry);
+                        }
+                    }
+                }
+            }
+
+            template <typename... Args>
+            DP_NOINLINE DP_COLD static T* MakeInstance(Entry& entry, Args&&... args) {
+                detail::MultitonInstance<T>& slot = entry.slot;
+                slot.once.Call([&]() {
+                    if constexpr (kTracksDestruction) {
+                        if (slot.destroyed) {
+                            LifetimePolicy<T>::OnDeadReference();
+                            slot.destroyed = false;
+                        }
+                    }
+                    T* p = CreationPolicy<T>::Create(std::forward<Args>(args)...);
+                    slot.instance.store(p, std::memory_order_release);
+                    if (!scheduled_.exchange(true, std::memory_order_acq_rel)) {
+                        detail::ScheduleDestruction<LifetimePolicy<T>>(p, &DestroySingleton);
+                    }
+                    });
+                return slot.instance.load(std::memory_order_acquire);
+            }
+
+            // Destroys every instance; keys stay registered
+            static void DestroySingleton() {
+                DestroyInstance(true);
+            }
+
+            static void DestroyInstance(bool markDestroyed) {
+                typename ThreadingModel<T>::Lock guard;
+                ForEachEntry([&](Entry& entry) {
+                    if (T* p = entry.slot.instance.exchange(nullptr, std::memory_order_acq_rel)) {
+                        entry.slot.once.Reset();
+                        CreationPolicy<T>::Destroy(p);
+                        if constexpr (kTracksDestruction) {
+                            entry.slot.destroyed = markDestroyed;
+                        }
+                    }
+                    });
+                scheduled_.store(false, std::memory_order_release);
+            }
+
+            static std::atomic<bool> scheduled_;
+    };
+
+    template
+        <
+        typename Key,
+        typename T,
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel,
+        typename Hash
+        >
+        std::atomic<bool> Multiton<Key, T, CreationPolicy, LifetimePolicy, ThreadingModel, Hash>::scheduled_{ false };
+
+    // Multiton for small dense integer keys 0..N-1: instances are reached
+    // by indexing a fixed array, with no hashing and no table lock at all
+    template
+        <
+        std::size_t N,
+        typename T,
+        template <typename> class CreationPolicy = DefaultCreationPolicy,
+        template <typename> class LifetimePolicy = DefaultLifetimePolicy,
+        template <typename> class ThreadingModel = DefaultThreadingModel
+        >
+        class DenseMultiton {
+        private:
+            static_assert(!HoldsSingleInstance<CreationPolicy<T>>::value,
+                "DenseMultiton needs a creation policy that can create several instances");
+            static_assert(!OwnsInstanceStorage<ThreadingModel<T>>::value,
+                "DenseMultiton needs a threading model with a real Lock");
+            static_assert(!ProvidesFallbackInstance<LifetimePolicy<T>, T>::value,
+                "DenseMultiton recreates destroyed instances: it cannot hand out a fallback instance");
+            static_assert(!SchedulesOneInstance<LifetimePolicy<T>, T>::value,
+                "DenseMultiton schedules all its instances together: it cannot use a lifetime policy that takes one instance (FastExit, SingletonWithLongevity)");
+
+            static constexpr bool kTracksDestruction = DestroysInstance<LifetimePolicy<T>>::value;
+
+        public:
+            // Instance for key, constructed from args on first use of that key;
+            // throws std::out_of_range for key >= N
+            template <typename... Args>
+            static T& Instance(std::size_t key, Args&&... args) {
+                if (DP_UNLIKELY(key >= N)) {
+                    detail::Raise<std::out_of_range>("DenseMultiton key out of range");
+                }
+                detail::MultitonInstance<T>& slot = slots_[key];
+                if (T* p = slot.instance.load(std::memory_order_acquire)) {
+                    return *p;
+                }
+                return *MakeInstance(slot, std::forward<Args>(args)...);
+            }
+
+            // Instance for key, or nullptr if it does not exist; never creates
+            static T* Find(std::size_t key) {
+                return key < N ? slots_[key].instance.load(std::memory_order_acquire) : nullptr;
+            }
+
+            // Calls f(key, instance) for every live instance
+            template <typename F>
+            static void ForEach(F&& f) {
+                for (std::size_t key = 0; key < N; ++key) {
+                    if (T* p = slots_[key].instance.load(std::memory_order_acquire)) {
+                        f(key, *p);
+                    }
+                }
+            }
+
+        private:
+            template <typename>
+            friend struct detail::SingletonAccess;
+
+            // Prevent creation, copying and assignment
+            DenseMultiton();
+            DenseMultiton(const DenseMultiton&);
+            DenseMultiton& operator=(const DenseMultiton&);
+
+            template <typename... Args>
+            DP_NOINLINE DP_COLD static T* MakeInstance(detail::MultitonInstance<T>& slot, Args&&... args) {
+                slot.once.Call([&]() {
+                    if constexpr (kTracksDestruction) {
+                        if (slot.destroyed) {
+                            LifetimePolicy<T>::OnDeadReference();
+                            slot.destroyed = false;
+                        }
+                    }
+                    T* p = CreationPolicy<T>::Create(std::forward<Args>(args)...);
+                    slot.instance.store(p, std::memory_order_release);
+                    if (!scheduled_.exchange(true, std::memory_order_acq_rel)) {
+                        detail::ScheduleDestruction<LifetimePolicy<T>>(p, &DestroySingleton);
+                    }
+                    });
+                return slot.instance.load(std::memory_order_acquire);
+            }
+
+            static void DestroySingleton() {
+                DestroyInstance(true);
+            }
+
+            static void DestroyInstance(bool markDestroyed) {
+                typename ThreadingModel<T>::Lock guard;
+                for (detail::MultitonInstance<T>& slot : slots_) {
+                    if (T* p = slot.instance.exchange(nullptr, std::memory_order_acq_rel)) {
+                        slot.once.Reset();
+                        CreationPolicy<T>::Destroy(p);
+                        if constexpr (kTracksDestruction) {
+                            slot.destroyed = markDestroyed;
+                        }
+                    }
+                }
+                scheduled_.store(false, std::memory_order_release);
+            }
+
+            // Constant-initialized: usable before any dynamic initialization
+            static detail::MultitonInstance<T> slots_[N];
+            static std::atomic<bool> scheduled_;
+    };
+
+    template
+        <
+        std::size_t N,
+        typename T,
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel
+        >
+        detail::MultitonInstance<T> DenseMultiton<N, T, CreationPolicy, LifetimePolicy, ThreadingModel>::slots_[N];
+
+    template
+        <
+        std::size_t N,
+        typename T,
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel
+        >
+        std::atomic<bool> DenseMultiton<N, T, CreationPolicy, LifetimePolicy, ThreadingModel>::scheduled_{ false };
+
+} // namespace dp
+
+#endif // MULTITON_HPP
@@ -0,0 +1,194 @@
+#ifndef NUMA_POLICY_HPP
+#define NUMA_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // for std::strtol
+#include <new> // for placement new
+#include <fstream>
+#include <string>
+#include <utility> // for std::forward
+#include "platform.hpp"
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dp {
+
+    // Node a CreateOnNode<T> instance is placed on. Specialize Node() to
+    // pin T to a fixed node; the default -1 means the calling thread's node
+    template <typename T>
+    struct NumaNodeOf {
+        static int Node() { return -1; }
+    };
+
+    namespace detail {
+
+        // NUMA node the calling thread is running on (0 where unknown)
+        inline int CurrentNumaNode() {
+#if defined(__linux__)
+            unsigned cpu = 0;
+            unsigned node = 0;
+            if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+                return static_cast<int>(node);
+            }
+#endif
+            return 0;
+        }
+
+        // Number of possible NUMA nodes (at least 1)
+        inline int NumaNodeCount() {
+            static const int count = []() {
+                std::ifstream possible("/sys/devices/system/node/possible");
+                std::string range;
+                if (possible >> range) {
+                    // Format is "0" or "0-N"
+                    std::size_t dash = range.find_last_of("-,");
+                    std::string last = dash == std::string::npos ? range : range.substr(dash + 1);
+                    char* end = nullptr;
+                    long highest = std::strtol(last.c_str(), &end, 10);
+                    if (end != last.c_str() && highest >= 0) {
+                        return static_cast<int>(highest) + 1;
+                    }
+                }
+                return 1;
+            }();
+            return count;
+        }
+
+#if defined(__linux__)
+        // Page-granular anonymous mapping with a NUMA memory policy, applied
+        // before any page is touched so the first fault places it
+        inline void* MapWithPolicy(std::size_t size, int mode, const unsigned long* mask, unsigned long maxNode) {
+            void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                return nullptr;
+            }
+            // Placement is best effort: without NUMA support the mapping is still usable
+            syscall(SYS_mbind, memory, size, mode, mask, maxNode, 0);
+            return memory;
+        }
+
+        inline std::size_t PageRounded(std::size_t size) {
+            std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return (size + page - 1) / page * page;
+        }
+#endif
+
+        // Creates T in memory placed by a NUMA memory policy; uses the heap
+        // on platforms without NUMA placement. Raises std::bad_alloc when
+        // the pages cannot be mapped, so Create never returns null
+        template <typename T>
+        struct NumaCreate {
+            template <typename Placement, typename... Args>
+            static T* Create(Placement placement, Args&&... args) {
+#if defined(__linux__)
+                std::size_t size = PageRounded(sizeof(T));
+                void* memory = placement(size);
+                if (!memory) {
+                    Raise<std::bad_alloc>("NUMA placement could not map memory for the instance");
+                }
+#if defined(DP_HAS_EXCEPTIONS)
+                try {
+                    return new(memory) T(std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    munmap(memory, size);
+                    throw;
+                }
+#else
+                return new(memory) T(std::forward<Args>(args)...);
+#endif
+#else
+                (void)placement;
+                return new T(std::forward<Args>(args)...);
+#endif
+            }
+
+            static void Destroy(T* p) {
+                if (!p) {
+                    return;
+                }
+#if defined(__linux__)
+                p->~T();
+                munmap(static_cast<void*>(p), PageRounded(sizeof(T)));
+#else
+                delete p;
+#endif
+            }
+        };
+
+    } // namespace detail
+
+    // Policy placing the instance on one NUMA node: NumaNodeOf<T>::Node(),
+    // or by default the node of the thread that creates it. Only T's own
+    // storage is placed (e.g. large std::array members); containers that
+    // allocate still use their allocator.
+    template <typename T>
+    struct CreateOnNode {
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            return detail::NumaCreate<T>::Create([](std::size_t size) -> void* {
+#if defined(__linux__)
+                int node = NumaNodeOf<T>::Node();
+                if (node < 0) {
+                    node = detail::CurrentNumaNode();
+                }
+                constexpr int kBits = static_cast<int>(8 * sizeof(unsigned long));
+                unsigned long mask[16] = {};
+                if (node >= 16 * kBits) {
+                    return detail::MapWithPolicy(size, MPOL_DEFAULT, nullptr, 0);
+                }
+                mask[node / kBits] = 1UL << (node % kBits);
+                // Preferred rather than bound, so a full node does not OOM-kill us
+                return detail::MapWithPolicy(size, MPOL_PREFERRED, mask, 16 * kBits);
+#else
+                (void)size;
+                return nullptr;
+#endif
+            }, std::forward<Args>(args)...);
+        }
+
+        static void Destroy(T* p) {
+            detail::NumaCreate<T>::Destroy(p);
+        }
+    };
+
+    // Policy interleaving the instance's pages across every allowed NUMA node
+    template <typename T>
+    struct CreateInterleaved {
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            return detail::NumaCreate<T>::Create([](std::size_t size) -> void* {
+#if defined(__linux__)
+                constexpr unsigned long kMaxNode = 16 * 8 * sizeof(unsigned long);
+                unsigned long allowed[16] = {};
+                if (syscall(SYS_get_mempolicy, nullptr, allowed, kMaxNode, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+                    return detail::MapWithPolicy(size, MPOL_DEFAULT, nullptr, 0);
+                }
+                return detail::MapWithPolicy(size, MPOL_INTERLEAVE, allowed, kMaxNode);
+#else
+                (void)size;
+                return nullptr;
+#endif
+            }, std::forward<Args>(args)...);
+        }
+
+        static void Destroy(T* p) {
+            detail::NumaCreate<T>::Destroy(p);
+        }
+    };
+
+    // Shard map for SingletonPerCpu giving one shard (replica) per NUMA node
+    struct PerNodeShards {
+        static std::size_t Count() { return static_cast<std::size_t>(detail::NumaNodeCount()); }
+        static std::size_t Current() { return static_cast<std::size_t>(detail::CurrentNumaNode()); }
+    };
+
+} // namespace dp
+
+#endif // NUMA_POLICY_HPP
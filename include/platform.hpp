@@ -0,0 +1,65 @@
+#ifndef PLATFORM_HPP
+#define PLATFORM_HPP
+
+#include <cstdio>
+#include <cstdlib> // for std::abort
+#include <type_traits>
+
+// Exceptions may be disabled (-fno-exceptions); the library then reports
+// the errors it would throw by printing them and aborting
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define DP_HAS_EXCEPTIONS 1
+#endif
+
+// Branch hints and out-of-line slow paths ([[likely]]/[[unlikely]] are C++20)
+#if defined(__GNUC__) || defined(__clang__)
+#define DP_LIKELY(x) __builtin_expect(!!(x), 1)
+#define DP_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define DP_NOINLINE __attribute__((noinline))
+#define DP_COLD __attribute__((cold))
+#define DP_FUNCTION __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+#define DP_LIKELY(x) (x)
+#define DP_UNLIKELY(x) (x)
+#define DP_NOINLINE __declspec(noinline)
+#define DP_COLD
+#define DP_FUNCTION __FUNCSIG__
+#else
+#define DP_LIKELY(x) (x)
+#define DP_UNLIKELY(x) (x)
+#define DP_NOINLINE
+#define DP_COLD
+#define DP_FUNCTION __func__
+#endif
+
+namespace dp {
+namespace detail {
+
+    // Prints a diagnostic naming where it came from and aborts
+    [[noreturn]] DP_NOINLINE DP_COLD inline void Fail(const char* what, const char* where) {
+        std::fprintf(stderr, "dp: %s (%s)\n", what, where);
+        std::fflush(stderr);
+        std::abort();
+    }
+
+    // Throws E(what) (or E() when E takes no message, e.g. std::bad_alloc),
+    // or without exceptions reports it through Fail().
+    // Out of line and cold, so callers carry no throw sequence inline
+    template <typename E>
+    [[noreturn]] DP_NOINLINE DP_COLD void Raise(const char* what) {
+#if defined(DP_HAS_EXCEPTIONS)
+        if constexpr (std::is_constructible_v<E, const char*>) {
+            throw E(what);
+        }
+        else {
+            throw E();
+        }
+#else
+        Fail(what, DP_FUNCTION);
+#endif
+    }
+
+} // namespace detail
+} // namespace dp
+
+#endif // PLATFORM_HPP
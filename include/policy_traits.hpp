@@ -0,0 +1,102 @@
+#ifndef POLICY_TRAITS_HPP
+#define POLICY_TRAITS_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace dp {
+
+    // Compile-time checks that a template argument fits its policy slot,
+    // so a mismatched or misspelled policy fails with one readable
+    // static_assert instead of deep inside Singleton
+
+    // Creation policy for T: static T* Create() and static void Destroy(T*).
+    // Create() is only required when T is default constructible
+    // (otherwise instances are created through Emplace(args...))
+    template <typename Policy, typename T, typename = void>
+    struct IsCreationPolicy : std::false_type {};
+
+    template <typename Policy, typename T>
+    struct IsCreationPolicy<Policy, T, std::void_t<decltype(Policy::Destroy(std::declval<T*>()))>>
+        : std::bool_constant<!std::is_default_constructible_v<T> ||
+            std::is_convertible_v<decltype(Policy::Create()), T*>> {};
+
+    namespace detail {
+        template <typename Policy, typename = void>
+        struct HasDeadReferenceHook : std::false_type {};
+
+        template <typename Policy>
+        struct HasDeadReferenceHook<Policy, std::void_t<decltype(Policy::OnDeadReference())>>
+            : std::true_type {};
+
+        template <typename Policy, typename = void>
+        struct SchedulesWithoutInstance : std::false_type {};
+
+        template <typename Policy>
+        struct SchedulesWithoutInstance<Policy, std::void_t<decltype(
+            Policy::ScheduleDestruction(std::declval<void (*)()>()))>>
+            : std::true_type {};
+
+        // Detects lifetime policies taking the instance as well (Loki's signature)
+        template <typename Policy, typename T, typename = void>
+        struct TakesInstance : std::false_type {};
+
+        template <typename Policy, typename T>
+        struct TakesInstance<Policy, T, std::void_t<decltype(
+            Policy::ScheduleDestruction(std::declval<T*>(), std::declval<void (*)()>()))>>
+            : std::true_type {};
+    } // namespace detail
+
+    // Lifetime policy for T: static void OnDeadReference() and
+    // static void ScheduleDestruction(void (*)()) or (T*, void (*)())
+    template <typename Policy, typename T>
+    struct IsLifetimePolicy : std::bool_constant<detail::HasDeadReferenceHook<Policy>::value &&
+        (detail::SchedulesWithoutInstance<Policy>::value || detail::TakesInstance<Policy, T>::value)> {};
+
+    // True for lifetime policies whose OnDeadReference() returns a T*
+    // to use instead of recreating the instance
+    template <typename Policy, typename T, typename = void>
+    struct ProvidesFallbackInstance : std::false_type {};
+
+    template <typename Policy, typename T>
+    struct ProvidesFallbackInstance<Policy, T, std::void_t<decltype(Policy::OnDeadReference())>>
+        : std::is_convertible<decltype(Policy::OnDeadReference()), T*> {};
+
+    // True for lifetime policies whose schedule follows one instance
+    // (ScheduleDestruction(T*, ...)): FastExit flushes it, and
+    // SingletonWithLongevity reads its longevity. Containers of several
+    // instances reject them, since they schedule all instances at once
+    template <typename Policy, typename T>
+    struct SchedulesOneInstance : detail::TakesInstance<Policy, T> {};
+
+    // Threading model: a default-constructible scoped Lock type
+    template <typename Model, typename = void>
+    struct IsThreadingModel : std::false_type {};
+
+    template <typename Model>
+    struct IsThreadingModel<Model, std::void_t<typename Model::Lock>>
+        : std::is_default_constructible<typename Model::Lock> {};
+
+    // False for lifetime policies that never destroy the instance
+    // (static constexpr bool DestroysInstance = false). Singletons using
+    // them drop dead-reference tracking altogether
+    template <typename Policy, typename = void>
+    struct DestroysInstance : std::true_type {};
+
+    template <typename Policy>
+    struct DestroysInstance<Policy, std::void_t<decltype(Policy::DestroysInstance)>>
+        : std::bool_constant<Policy::DestroysInstance> {};
+
+    // True for lifetime policies that stay correct when each thread's
+    // instance is destroyed at thread exit rather than on their schedule
+    // (static constexpr bool SupportsPerThreadInstances = true)
+    template <typename Policy, typename = void>
+    struct SupportsPerThreadInstances : std::false_type {};
+
+    template <typename Policy>
+    struct SupportsPerThreadInstances<Policy, std::void_t<decltype(Policy::SupportsPerThreadInstances)>>
+        : std::bool_constant<Policy::SupportsPerThreadInstances> {};
+
+} // namespace dp
+
+#endif // POLICY_TRAITS_HPP
@@ -0,0 +1,164 @@
+#ifndef SHARDED_SINGLETON_HPP
+#define SHARDED_SINGLETON_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include "creation_policy.hpp"
+#include "lifetime_policy.hpp"
+#include "policy_traits.hpp"
+#include "threading_policy.hpp"
+#include "sync_primitives.hpp"
+
+namespace dp {
+
+    // Shard map giving one shard per CPU
+    struct PerCpuShards {
+        static std::size_t Count() { return detail::CpuCount(); }
+        static std::size_t Current() { return detail::CurrentCpu(); }
+    };
+
+    // Singleton sharded per CPU: one cache-line-aligned T per CPU, each
+    // created on first use through CreationPolicy, so writes from
+    // different cores never touch the same line. A thread can migrate
+    // between picking its shard and using it, so T must still be safe for
+    // concurrent use (typically relaxed atomics); sharding removes the
+    // contention, not the need for synchronization.
+    // ShardMap decides how many shards there are and which one is local
+    // (PerCpuShards, or PerNodeShards from numa_policy.hpp).
+    template
+        <
+        typename T,
+        template <typename> class CreationPolicy = DefaultCreationPolicy,
+        template <typename> class LifetimePolicy = DefaultLifetimePolicy,
+        template <typename> class ThreadingModel = DefaultThreadingModel,
+        typename ShardMap = PerCpuShards
+        >
+        class SingletonPerCpu {
+        private:
+            // Shard storage padded to whole cache lines
+            struct alignas(detail::kCacheLineSize) Padded {
+                T value;
+            };
+
+            static_assert(!HoldsSingleInstance<CreationPolicy<Padded>>::value,
+                "SingletonPerCpu needs a creation policy that can create several instances");
+            static_assert(!OwnsInstanceStorage<ThreadingModel<Padded>>::value,
+                "SingletonPerCpu needs a threading model with a real Lock");
+            static_assert(!ProvidesFallbackInstance<LifetimePolicy<T>, T>::value,
+                "SingletonPerCpu recreates destroyed shards: it cannot hand out a fallback instance");
+            static_assert(!SchedulesOneInstance<LifetimePolicy<T>, T>::value,
+                "SingletonPerCpu schedules all its shards together: it cannot use a lifetime policy that takes one instance (FastExit, SingletonWithLongevity)");
+
+        public:
+            // Shard of the CPU (or node) the caller is running on
+            static T& Local() {
+                return Shard(ShardMap::Current() % ShardCount());
+            }
+
+            // Shard by index, created on first use
+            static T& Shard(std::size_t index) {
+                Padded* p = Slots()[index].load(std::memory_order_acquire);
+                if (!p) {
+                    p = MakeShard(index);
+                }
+                return p->value;
+            }
+
+            static std::size_t ShardCount() {
+                static const std::size_t count = ShardMap::Count() ? ShardMap::Count() : 1;
+                return count;
+            }
+
+            // Visits every shard created so far
+            template <typename F>
+            static void ForEach(F&& f) {
+                std::atomic<Padded*>* slots = Slots();
+                for (std::size_t i = 0; i < ShardCount(); ++i) {
+                    if (Padded* p = slots[i].load(std::memory_order_acquire)) {
+                        f(p->value);
+                    }
+                }
+            }
+
+            // Folds f(accumulator, shard) over every shard created so far
+            template <typename R, typename F>
+            static R Reduce(R init, F&& f) {
+                ForEach([&](T& shard) { init = f(std::move(init), shard); });
+                return init;
+            }
+
+        private:
+            // Prevent creation, copying and assignment
+            SingletonPerCpu();
+            SingletonPerCpu(const SingletonPerCpu&);
+            SingletonPerCpu& operator=(const SingletonPerCpu&);
+
+            // Shard pointers; read-mostly, so they share lines safely
+            static std::atomic<Padded*>* Slots() {
+                static std::atomic<Padded*>* slots = new std::atomic<Padded*>[ShardCount()]();
+                return slots;
+            }
+
+            static Padded* MakeShard(std::size_t index) {
+                typename ThreadingModel<Padded>::Lock guard;
+                std::atomic<Padded*>& slot = Slots()[index];
+                Padded* p = slot.load(std::memory_order_relaxed);
+                if (!p) {
+                    if constexpr (DestroysInstance<LifetimePolicy<T>>::value) {
+                        if (destroyed_) {
+                            LifetimePolicy<T>::OnDeadReference();
+                            destroyed_ = false;
+                        }
+                    }
+                    p = CreationPolicy<Padded>::Create();
+                    slot.store(p, std::memory_order_release);
+                    if (!scheduled_) {
+                        scheduled_ = true;
+                        detail::ScheduleDestruction<LifetimePolicy<T>>(&p->value, &DestroyShards);
+                    }
+                }
+                return p;
+            }
+
+            static void DestroyShards() {
+                typename ThreadingModel<Padded>::Lock guard;
+                std::atomic<Padded*>* slots = Slots();
+                for (std::size_t i = 0; i < ShardCount(); ++i) {
+                    CreationPolicy<Padded>::Destroy(slots[i].exchange(nullptr, std::memory_order_acq_rel));
+                }
+                scheduled_ = false;
+                if constexpr (DestroysInstance<LifetimePolicy<T>>::value) {
+                    destroyed_ = true;
+                }
+            }
+
+            // Static class members; only accessed under the lock
+            static bool scheduled_;
+            static bool destroyed_;
+    };
+
+    // Static members initialization
+    template
+        <
+        typename T,
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel,
+        typename ShardMap
+        >
+        bool SingletonPerCpu<T, CreationPolicy, LifetimePolicy, ThreadingModel, ShardMap>::scheduled_ = false;
+
+    template
+        <
+        typename T,
+        template <typename> class CreationPolicy,
+        template <typename> class LifetimePolicy,
+        template <typename> class ThreadingModel,
+        typename ShardMap
+        >
+        bool SingletonPerCpu<T, CreationPolicy, LifetimePolicy, ThreadingModel, ShardMap>::destroyed_ = false;
+
+} // namespace dp
+
+#endif // SHARDED_SINGLETON_HPP
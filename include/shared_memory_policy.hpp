@@ -0,0 +1,250 @@
+#ifndef SHARED_MEMORY_POLICY_HPP
+#define SHARED_MEMORY_POLICY_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new> // for placement new
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility> // for std::forward
+#include "creation_policy.hpp"
+#include "mapped_policy.hpp" // for OffsetPtr
+#include "sync_primitives.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h> // for kill
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DP_HAS_SHARED_MEMORY 1
+#endif
+
+namespace dp {
+
+    // Name of the POSIX shared memory object holding a
+    // CreateInSharedMemory<T> instance ("/name"). Specialize it for T;
+    // with the default empty name each process builds its own copy on the
+    // heap. Change Name() or Version() whenever the layout of T changes
+    template <typename T>
+    struct SharedMemoryOf {
+        static std::string Name() { return std::string(); }
+        static std::uint32_t Version() { return 1; }
+    };
+
+    namespace detail {
+
+        // Header in front of T in the segment. A fresh segment is zero
+        // filled, so state starts out empty
+        struct SharedSegmentHeader {
+            static constexpr std::uint32_t kEmpty = 0;
+            static constexpr std::uint32_t kReady = 0xffffffffu;
+
+            std::atomic<std::uint32_t> state; // kEmpty, kReady or the builder's pid
+            std::uint32_t version;
+            std::uint64_t size;
+            std::uint64_t alignment;
+            std::uint64_t typeHash;
+        };
+
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+            "The segment state must be lock-free to work across processes");
+
+    } // namespace detail
+
+    // Policy placing one instance of T in POSIX shared memory for every
+    // process on the host. Whichever process first finds the segment
+    // empty claims it by storing its pid in the header, constructs T and
+    // marks it ready; the rest wait on the header (a process-shared
+    // futex) and attach. A waiter that finds the builder's process gone
+    // claims the segment and builds again, so a crash mid-construction
+    // does not wedge the others.
+    // Once ready, the segment is mapped read-only in every process:
+    // writing to the instance faults. T must be self-contained (no heap
+    // memory, OffsetPtr instead of pointers) and trivially destructible;
+    // the segment outlives the processes until Remove() is called.
+    // Within a process the Singleton's threading model still applies.
+    template <typename T>
+    struct CreateInSharedMemory {
+        static_assert(std::is_trivially_destructible_v<T>,
+            "Shared instances are unmapped, never destroyed: T must be trivially destructible");
+
+        template <typename... Args>
+        static T* Create(Args&&... args) {
+            State& state = GetState();
+            state.attached = false;
+#if defined(DP_HAS_SHARED_MEMORY)
+            std::string name = SharedMemoryOf<T>::Name();
+            if (!name.empty()) {
+                if (void* base = Map(name)) {
+                    T* p = nullptr;
+                    bool built = false;
+#if defined(DP_HAS_EXCEPTIONS)
+                    try {
+                        p = Join(base, built, std::forward<Args>(args)...);
+                    }
+                    catch (...) {
+                        ::munmap(base, kSegmentSize);
+                        throw;
+                    }
+#else
+                    p = Join(base, built, std::forward<Args>(args)...);
+#endif
+                    if (p) {
+                        state.base = base;
+                        state.attached = !built;
+                        return p;
+                    }
+                    // Built by an incompatible version of T
+                    ::munmap(base, kSegmentSize);
+                }
+            }
+#endif
+            state.base = nullptr;
+            return new T(std::forward<Args>(args)...);
+        }
+
+        static void Destroy(T* p) {
+            if (!p) {
+                return;
+            }
+            State& state = GetState();
+#if defined(DP_HAS_SHARED_MEMORY)
+            if (state.base) {
+                ::munmap(state.base, kSegmentSize);
+                state.base = nullptr;
+                return;
+            }
+#endif
+            delete p;
+        }
+
+        // Whether the current instance was built by another process
+        static bool Attached() {
+            return GetState().attached;
+        }
+
+        // Unlinks the segment; processes attached keep their mapping and
+        // the next Create() builds a new one
+        static void Remove() {
+#if defined(DP_HAS_SHARED_MEMORY)
+            std::string name = SharedMemoryOf<T>::Name();
+            if (!name.empty()) {
+                ::shm_unlink(name.c_str());
+            }
+#endif
+        }
+
+    private:
+        using Header = detail::SharedSegmentHeader;
+
+        struct State {
+            void* base = nullptr; // Segment mapping, null for the heap
+            bool attached = false;
+        };
+
+        static State& GetState() {
+            static State state;
+            return state;
+        }
+
+        static constexpr std::size_t kDataOffset =
+            (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+        static constexpr std::size_t kSegmentSize = kDataOffset + sizeof(T);
+        static constexpr int kPollMs = 10; // How often a waiter checks the builder is alive
+
+        static T* Data(void* base) {
+            return std::launder(reinterpret_cast<T*>(static_cast<char*>(base) + kDataOffset));
+        }
+
+#if defined(DP_HAS_SHARED_MEMORY)
+        // Opens (creating if needed) and maps the segment read-write
+        static void* Map(const std::string& name) {
+            int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+            if (fd < 0) {
+                return nullptr;
+            }
+            struct stat info;
+            void* base = MAP_FAILED;
+            if (::fstat(fd, &info) == 0 && info.st_size == 0) {
+                // Concurrent creators all extend it to the same size
+                if (::ftruncate(fd, static_cast<off_t>(kSegmentSize)) != 0 || ::fstat(fd, &info) != 0) {
+                    info.st_size = 0;
+                }
+            }
+            if (static_cast<std::size_t>(info.st_size) == kSegmentSize) {
+                base = ::mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            ::close(fd);
+            return base == MAP_FAILED ? nullptr : base;
+        }
+
+        static bool BuilderGone(std::uint32_t pid, std::uint32_t self) {
+            return pid == self || (::kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH);
+        }
+
+        // Builds T or waits for another process to; returns the instance
+        // once ready, or nullptr if the segment holds an incompatible T
+        template <typename... Args>
+        static T* Join(void* base, bool& built, Args&&... args) {
+            Header* header = static_cast<Header*>(base);
+            const std::uint32_t self = static_cast<std::uint32_t>(::getpid());
+            for (;;) {
+                std::uint32_t s = header->state.load(std::memory_order_acquire);
+                if (s == Header::kReady) {
+                    break;
+                }
+                if (s == Header::kEmpty || BuilderGone(s, self)) {
+                    if (header->state.compare_exchange_strong(s, self, std::memory_order_acquire)) {
+                        Build(header, std::forward<Args>(args)...);
+                        built = true;
+                        break;
+                    }
+                    continue;
+                }
+                detail::WaitOnSharedAddress(header->state, s, kPollMs);
+            }
+
+            if (header->version != SharedMemoryOf<T>::Version() || header->size != sizeof(T) ||
+                header->alignment != alignof(T) || header->typeHash != detail::TypeNameHash(typeid(T).name())) {
+                return nullptr;
+            }
+            ::mprotect(base, kSegmentSize, PROT_READ);
+            return Data(base);
+        }
+
+        // Caller has claimed the segment
+        template <typename... Args>
+        static void Build(Header* header, Args&&... args) {
+#if defined(DP_HAS_EXCEPTIONS)
+            try {
+                new(Data(header)) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                // Let a waiter (or a later caller) retry
+                header->state.store(Header::kEmpty, std::memory_order_release);
+                detail::WakeAllShared(header->state);
+                throw;
+            }
+#else
+            new(Data(header)) T(std::forward<Args>(args)...);
+#endif
+            header->version = SharedMemoryOf<T>::Version();
+            header->size = sizeof(T);
+            header->alignment = alignof(T);
+            header->typeHash = detail::TypeNameHash(typeid(T).name());
+            header->state.store(Header::kReady, std::memory_order_release);
+            detail::WakeAllShared(header->state);
+        }
+#endif
+    };
+
+    template <typename T>
+    struct HoldsSingleInstance<CreateInSharedMemory<T>> : std::true_type {};
+
+} // namespace dp
+
+#endif // SHARED_MEMORY_POLICY_HPP
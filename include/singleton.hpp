@@ -2,55 +2,344 @@
 #define SINGLETON_HPP
 
 #include <cstdlib> // for atexit
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility> // for std::forward
 #include "creation_policy.hpp"
 #include "threading_policy.hpp"
 #include "lifetime_policy.hpp"
+#include "platform.hpp"
+#include "policy_traits.hpp"
+#include "instrumentation_policy.hpp"
 
 namespace dp {
 
-    // Main Singleton template with three orthogonal policies
+    namespace detail {
+        template <typename S>
+        struct SingletonAccess;
+
+        // Singleton state; the dead-reference flag exists only for
+        // lifetime policies that destroy the instance
+        template <typename T, bool TracksDestruction>
+        struct SingletonControl {
+            std::atomic<T*> instance{ nullptr };
+        };
+
+        template <typename T>
+        struct SingletonControl<T, true> : SingletonControl<T, false> {
+            bool destroyed = false;
+        };
+    } // namespace detail
+
+    // Main Singleton template with three orthogonal policies, plus an
+    // optional instrumentation policy (NoInstrumentation or Instrumented)
     template
         <
         typename T,
         template <typename> class CreationPolicy = DefaultCreationPolicy,
         template <typename> class LifetimePolicy = DefaultLifetimePolicy,
-        template <typename> class ThreadingModel = DefaultThreadingModel
+        template <typename> class ThreadingModel = DefaultThreadingModel,
+        template <typename> class InstrumentationPolicy = NoInstrumentation
         >
         class Singleton {
+        private:
+            static_assert(IsCreationPolicy<CreationPolicy<T>, T>::value,
+                "CreationPolicy<T> must provide static T* Create() and static void Destroy(T*)");
+            static_assert(IsLifetimePolicy<LifetimePolicy<T>, T>::value,
+                "LifetimePolicy<T> must provide static ScheduleDestruction(void (*)()) or "
+                "ScheduleDestruction(T*, void (*)()), and static OnDeadReference()");
+            static_assert(IsThreadingModel<ThreadingModel<T>>::value,
+                "ThreadingModel<T> must provide a default-constructible Lock");
+            static_assert(!(HoldsSingleInstance<CreationPolicy<T>>::value &&
+                HasPerThreadInstances<ThreadingModel<T>>::value),
+                "A threading model with per-thread instances needs a creation policy that can create several");
+            static_assert(!HasPerThreadInstances<ThreadingModel<T>>::value ||
+                SupportsPerThreadInstances<LifetimePolicy<T>>::value,
+                "Per-thread instances are destroyed at thread exit, ignoring the lifetime policy's "
+                "schedule: use DestroyAtThreadExit or PhoenixSingleton");
+            static_assert(!(ProvidesFallbackInstance<LifetimePolicy<T>, T>::value &&
+                OwnsInstanceStorage<ThreadingModel<T>>::value),
+                "A fallback instance on dead reference needs a threading model that does not own instance storage");
+#if defined(DP_MULTITHREADED)
+            static_assert(!IsSingleThreaded<ThreadingModel<T>>::value,
+                "SingleThreaded is not allowed when DP_MULTITHREADED is defined");
+#endif
+
+            // Lifetime policies that never destroy need no dead-reference tracking
+            static constexpr bool kTracksDestruction = DestroysInstance<LifetimePolicy<T>>::value;
+
         public:
             // Returns the single instance of the class
             static T& Instance() {
-                if (!pInstance_) {
-                    typename ThreadingModel<T>::Lock guard;
-                    if (!pInstance_) {
-                        if (destroyed_) {
-                            LifetimePolicy<T>::OnDeadReference();
-                            destroyed_ = false;
-                        }
-                        pInstance_ = CreationPolicy<T>::Create();
-                        LifetimePolicy<T>::ScheduleDestruction(&DestroySingleton);
+                InstrumentationPolicy<T>::OnAccess();
+                if constexpr (OwnsInstanceStorage<ThreadingModel<T>>::value) {
+                    return ThreadingModel<T>::template Instance<Factory>();
+                }
+                else {
+                    return SharedInstance();
+                }
+            }
+
+            // Returns the instance, constructing it from args if it does not
+            // exist yet; args are ignored once the instance exists
+            template <typename Arg, typename... Args>
+            static T& Instance(Arg&& arg, Args&&... args) {
+                InstrumentationPolicy<T>::OnAccess();
+                if constexpr (OwnsInstanceStorage<ThreadingModel<T>>::value) {
+                    return ThreadingModel<T>::template Instance<Factory>(std::forward<Arg>(arg), std::forward<Args>(args)...);
+                }
+                else {
+                    T* p = control_.instance.load(std::memory_order_acquire);
+                    if (DP_UNLIKELY(!p)) {
+                        p = MakeInstance(false, std::forward<Arg>(arg), std::forward<Args>(args)...);
                     }
+                    return *p;
+                }
+            }
+
+            // Constructs the instance in place from args (e.g. a prebuilt T
+            // to move from); throws std::logic_error if it already exists
+            template <typename... Args>
+            static T& Emplace(Args&&... args) {
+                if constexpr (OwnsInstanceStorage<ThreadingModel<T>>::value) {
+                    return ThreadingModel<T>::template Emplace<Factory>(std::forward<Args>(args)...);
+                }
+                else {
+                    return *MakeInstance(true, std::forward<Args>(args)...);
+                }
+            }
+
+            // Guarded access when T is an access policy (Guarded<U> from
+            // access_policy.hpp): a guard holding shared or exclusive access
+            // to the instance's state until it goes out of scope
+            template <typename U = T>
+            static auto Read() -> decltype(std::declval<U&>().Read()) {
+                return Instance().Read();
+            }
+
+            template <typename U = T>
+            static auto Write() -> decltype(std::declval<U&>().Write()) {
+                return Instance().Write();
+            }
+
+            // Starts constructing the instance on a background thread and
+            // returns at once. A later Instance() returns the instance, or
+            // waits for the construction already under way
+            static void Prefetch() {
+                (void)InstanceAsync();
+            }
+
+            // Future of the instance, constructed on a background thread
+            // through Instance() unless it already exists (or is being
+            // built); construction errors are delivered through the future
+            static std::shared_future<T&> InstanceAsync() {
+                static_assert(!HasPerThreadInstances<ThreadingModel<T>>::value,
+                    "A background thread cannot construct another thread's instance");
+                static_assert(!IsSingleThreaded<ThreadingModel<T>>::value,
+                    "Background construction races with Instance() on the calling thread: "
+                    "SingleThreaded would build the instance twice without a lock");
+                AsyncConstruction& async = Async();
+                std::lock_guard<std::mutex> guard(async.mtx);
+                if (async.future.valid() && !IsStale(async.future)) {
+                    return async.future;
+                }
+                if (T* p = Peek()) {
+                    std::promise<T&> ready;
+                    ready.set_value(*p);
+                    async.future = ready.get_future().share();
                 }
-                return *pInstance_;
+                else {
+                    detail::MarkMultithreaded();
+                    async.future = std::async(std::launch::async, []() -> T& { return Instance(); }).share();
+                }
+                return async.future;
             }
 
+            // Instance pointer resolved once, for hoisting out of hot loops.
+            // Release builds dereference it directly. Debug builds check it
+            // is still the live instance on every access and re-resolve via
+            // Instance() if not, so DefaultLifetime still reports the dead
+            // reference and PhoenixSingleton still recreates.
+            class Ref {
+            public:
+                Ref() : p_(&Instance()) {}
+
+                T& operator*() const { return *Get(); }
+                T* operator->() const { return Get(); }
+
+                T* Get() const {
+#ifndef NDEBUG
+                    if (Peek() != p_) {
+                        p_ = &Instance();
+                    }
+#endif
+                    return p_;
+                }
+
+                // Re-resolves after a known destruction/recreation
+                void Refresh() { p_ = &Instance(); }
+
+            private:
+                mutable T* p_;
+            };
+
         private:
+            template <typename>
+            friend struct detail::SingletonAccess;
+
             // Prevent creation, copying and assignment
             Singleton();
             Singleton(const Singleton&);
             Singleton& operator=(const Singleton&);
 
+            // Creation and lifetime hooks, also handed to threading models that own storage
+            struct Factory {
+                using Lifetime = LifetimePolicy<T>;
+
+                // A T without a (public) default constructor is only ever
+                // created by Emplace() or Instance(args); a plain Instance()
+                // before that throws instead of failing to compile
+                template <typename... Args>
+                static T* Create(Args&&... args) {
+                    if constexpr (sizeof...(Args) == 0 && !std::is_default_constructible_v<T>) {
+                        detail::Raise<std::logic_error>("Singleton instance must be created with Emplace() first");
+                    }
+                    else {
+                        std::uint64_t start = detail::TimestampIf<InstrumentationPolicy<T>>();
+                        T* p = CreationPolicy<T>::Create(std::forward<Args>(args)...);
+                        InstrumentationPolicy<T>::OnCreated(detail::ElapsedSince<InstrumentationPolicy<T>>(start));
+                        return p;
+                    }
+                }
+                static void Destroy(T* p) { CreationPolicy<T>::Destroy(p); }
+                static void OnDeadReference() { LifetimePolicy<T>::OnDeadReference(); }
+
+                // Hands a process-wide instance to the lifetime policy
+                static void ScheduleDestruction(T* p) {
+                    detail::ScheduleDestruction<LifetimePolicy<T>>(p, &DestroySingleton);
+                }
+            };
+
+            // Last future handed out by InstanceAsync()
+            struct AsyncConstruction {
+                std::mutex mtx;
+                std::shared_future<T&> future;
+            };
+
+            static AsyncConstruction& Async() {
+                static AsyncConstruction async;
+                return async;
+            }
+
+            // A finished future is stale once it failed or its instance was
+            // destroyed; an unfinished one is the construction in flight
+            static bool IsStale(const std::shared_future<T&>& future) {
+                if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return false;
+                }
+#if defined(DP_HAS_EXCEPTIONS)
+                try {
+                    return &future.get() != Peek();
+                }
+                catch (...) {
+                    return true;
+                }
+#else
+                return &future.get() != Peek();
+#endif
+            }
+
+            // Current instance, or nullptr if none exists; never creates
+            static T* Peek() {
+                if constexpr (OwnsInstanceStorage<ThreadingModel<T>>::value) {
+                    return ThreadingModel<T>::template Peek<Factory>();
+                }
+                else {
+                    return control_.instance.load(std::memory_order_acquire);
+                }
+            }
+
+            // Process-wide instance shared by all threads
+            static T& SharedInstance() {
+                // Fast path: a single acquire load pairs with the release
+                // store in MakeInstance(), so a non-null pointer always
+                // refers to a fully constructed object
+                T* p = control_.instance.load(std::memory_order_acquire);
+                if (DP_UNLIKELY(!p)) {
+                    p = MakeInstance(false);
+                }
+                return *p;
+            }
+
+            // Slow path: creates the instance from args under the threading
+            // model lock; with mustCreate, an existing instance is an error.
+            // Kept out of line so Instance() inlines to a load and a branch
+            template <typename... Args>
+            DP_NOINLINE DP_COLD static T* MakeInstance(bool mustCreate, Args&&... args) {
+                std::uint64_t waitStart = detail::TimestampIf<InstrumentationPolicy<T>>();
+                typename ThreadingModel<T>::Lock guard;
+                InstrumentationPolicy<T>::OnLockAcquired(detail::ElapsedSince<InstrumentationPolicy<T>>(waitStart));
+                T* p = control_.instance.load(std::memory_order_relaxed);
+                if (p) {
+                    InstrumentationPolicy<T>::OnLostRace();
+                }
+                if (p && mustCreate) {
+                    detail::Raise<std::logic_error>("Singleton instance already exists");
+                }
+                if (!p) {
+                    if constexpr (kTracksDestruction) {
+                        if (control_.destroyed) {
+                            if constexpr (ProvidesFallbackInstance<LifetimePolicy<T>, T>::value) {
+                                // Stays destroyed: every later access gets the fallback too
+                                return LifetimePolicy<T>::OnDeadReference();
+                            }
+                            else {
+                                LifetimePolicy<T>::OnDeadReference();
+                                control_.destroyed = false;
+                            }
+                        }
+                    }
+                    p = Factory::Create(std::forward<Args>(args)...);
+                    control_.instance.store(p, std::memory_order_release);
+                    detail::ScheduleDestruction<LifetimePolicy<T>>(p, &DestroySingleton);
+                }
+                return p;
+            }
+
             // Instance destruction function
             static void DestroySingleton() {
-                typename ThreadingModel<T>::Lock guard;
-                CreationPolicy<T>::Destroy(pInstance_);
-                pInstance_ = nullptr;
-                destroyed_ = true;
+                DestroyInstance(true);
+            }
+
+            // Destroys the instance; markDestroyed controls whether a later
+            // access counts as a dead reference
+            static void DestroyInstance(bool markDestroyed) {
+                if constexpr (OwnsInstanceStorage<ThreadingModel<T>>::value) {
+                    ThreadingModel<T>::template Destroy<Factory>(markDestroyed);
+                }
+                else {
+                    typename ThreadingModel<T>::Lock guard;
+                    CreationPolicy<T>::Destroy(control_.instance.load(std::memory_order_relaxed));
+                    control_.instance.store(nullptr, std::memory_order_release);
+                    if constexpr (kTracksDestruction) {
+                        control_.destroyed = markDestroyed;
+                    }
+                }
             }
 
-            // Static class members
-            static T* pInstance_;
-            static bool destroyed_;
+            // Control block, alone on its cache line(s): the instance pointer
+            // every Instance() call loads never shares a line with a lock
+            // word (the threading models pad theirs too) or with another
+            // singleton's state. destroyed is only accessed under the lock,
+            // and only exists with kTracksDestruction
+            struct alignas(detail::kCacheLineSize) Control : detail::SingletonControl<T, kTracksDestruction> {};
+
+            static Control control_;
     };
 
     // Static members initialization
@@ -59,18 +348,27 @@ namespace dp {
         typename T,
         template <typename> class CreationPolicy,
         template <typename> class LifetimePolicy,
-        template <typename> class ThreadingModel
+        template <typename> class ThreadingModel,
+        template <typename> class InstrumentationPolicy
         >
-        T* Singleton<T, CreationPolicy, LifetimePolicy, ThreadingModel>::pInstance_ = nullptr;
+        typename Singleton<T, CreationPolicy, LifetimePolicy, ThreadingModel, InstrumentationPolicy>::Control
+        Singleton<T, CreationPolicy, LifetimePolicy, ThreadingModel, InstrumentationPolicy>::control_;
 
-    template
-        <
-        typename T,
-        template <typename> class CreationPolicy,
-        template <typename> class LifetimePolicy,
-        template <typename> class ThreadingModel
-        >
-        bool Singleton<T, CreationPolicy, LifetimePolicy, ThreadingModel>::destroyed_ = false;
+    namespace detail {
+
+        // Destroys a singleton the way its scheduled exit handler would
+        // (for per-thread models: the calling thread's instance).
+        // Intended for tests and benchmarks.
+        template <typename S>
+        struct SingletonAccess {
+            static void Destroy() { S::DestroySingleton(); }
+
+            // Destroys without recording a dead reference, so the next
+            // access simply creates a fresh instance
+            static void Reset() { S::DestroyInstance(false); }
+        };
+
+    } // namespace detail
 
 } // namespace dp
 
@@ -0,0 +1,216 @@
+#ifndef SWAPPABLE_SINGLETON_HPP
+#define SWAPPABLE_SINGLETON_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "sync_primitives.hpp"
+
+namespace dp {
+
+    namespace detail {
+
+        // Epoch-based read-side protection shared by every SwappableSingleton.
+        // Readers publish the epoch they entered in; a writer bumps the epoch
+        // and waits until no reader is still inside an older one.
+        class EpochDomain {
+        public:
+            struct alignas(kCacheLineSize) Record {
+                std::atomic<std::uint64_t> epoch{ 0 }; // 0 = not reading
+                std::atomic<bool> inUse{ false };
+                Record* next = nullptr;
+                unsigned depth = 0; // Owning thread only
+            };
+
+            // Deliberately leaked: records may be used until the last thread exits
+            static EpochDomain& Global() {
+                static EpochDomain* domain = new EpochDomain();
+                return *domain;
+            }
+
+            // Calling thread's record, acquired on first use and released at thread exit
+            Record& Local() {
+                struct Handle {
+                    Record* record;
+                    ~Handle() { record->inUse.store(false, std::memory_order_release); }
+                };
+                static thread_local Handle handle{ Acquire() };
+                return *handle.record;
+            }
+
+            void Enter(Record& record) {
+                if (record.depth++ == 0) {
+                    record.epoch.store(epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    // Orders the epoch store before the reader's load of the pointer
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            void Exit(Record& record) {
+                if (--record.depth == 0) {
+                    record.epoch.store(0, std::memory_order_release);
+                }
+            }
+
+            // Returns once every reader that could have seen a pointer
+            // replaced before this call has left its read-side section
+            void Synchronize() {
+                std::uint64_t target = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+                // Pairs with the fence in Enter(): either the reader sees the
+                // new pointer, or this sees the reader's epoch
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                for (Record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+                    for (;;) {
+                        std::uint64_t e = r->epoch.load(std::memory_order_acquire);
+                        if (e == 0 || e >= target) {
+                            break;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+        private:
+            Record* Acquire() {
+                for (Record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+                    bool expected = false;
+                    if (!r->inUse.load(std::memory_order_relaxed) &&
+                        r->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                        return r;
+                    }
+                }
+                Record* r = new Record();
+                r->inUse.store(true, std::memory_order_relaxed);
+                Record* head = head_.load(std::memory_order_relaxed);
+                do {
+                    r->next = head;
+                } while (!head_.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+                return r;
+            }
+
+            std::atomic<std::uint64_t> epoch_{ 1 };
+            std::atomic<Record*> head_{ nullptr };
+        };
+
+    } // namespace detail
+
+    // Read-mostly singleton whose instance can be replaced while readers run.
+    // Readers take a Snapshot: a store, a fence and a load on entry and one
+    // store on exit, with no lock and no shared reference count. Writers publish a complete new T; the
+    // previous version is released once every reader that might see it has
+    // finished. Versions are owned through std::shared_ptr, as in
+    // CreateUsingSharedPtr, so Acquire() can keep one alive past a snapshot.
+    template <typename T>
+    class SwappableSingleton {
+    private:
+        struct Version {
+            std::shared_ptr<const T> value;
+        };
+
+    public:
+        // Read-side section pinning the current version. Do not call
+        // Publish() from a thread that holds a Snapshot.
+        class Snapshot {
+        public:
+            Snapshot() : record_(detail::EpochDomain::Global().Local()) {
+                // Initialize outside the section: a writer may hold the lock
+                // while waiting for readers
+                EnsureInitialized();
+                detail::EpochDomain::Global().Enter(record_);
+                version_ = GetState().current.load(std::memory_order_acquire);
+            }
+
+            ~Snapshot() {
+                detail::EpochDomain::Global().Exit(record_);
+            }
+
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            const T& operator*() const { return *version_->value; }
+            const T* operator->() const { return version_->value.get(); }
+            const T* Get() const { return version_->value.get(); }
+
+            // Shared ownership of this version, valid after the snapshot ends
+            std::shared_ptr<const T> Share() const { return version_->value; }
+
+        private:
+            detail::EpochDomain::Record& record_;
+            Version* version_;
+        };
+
+        static Snapshot Read() {
+            return Snapshot();
+        }
+
+        // Shared ownership of the current version
+        static std::shared_ptr<const T> Acquire() {
+            return Read().Share();
+        }
+
+        // Replaces the instance and returns once the previous one is released
+        static void Publish(std::shared_ptr<const T> next) {
+            assert(detail::EpochDomain::Global().Local().depth == 0 &&
+                "SwappableSingleton::Publish called while holding a Snapshot");
+            State& state = GetState();
+            std::lock_guard<std::mutex> guard(state.writer);
+            Version* old = state.current.exchange(new Version{ std::move(next) }, std::memory_order_seq_cst);
+            detail::EpochDomain::Global().Synchronize();
+            delete old;
+        }
+
+        template <typename... Args>
+        static void Emplace(Args&&... args) {
+            Publish(std::make_shared<const T>(std::forward<Args>(args)...));
+        }
+
+        // Copies the current version, applies f to the copy and publishes it
+        template <typename F>
+        static void Update(F&& f) {
+            std::shared_ptr<T> next = std::make_shared<T>(*Acquire());
+            f(*next);
+            Publish(std::move(next));
+        }
+
+    private:
+        // Prevent creation, copying and assignment
+        SwappableSingleton();
+        SwappableSingleton(const SwappableSingleton&);
+        SwappableSingleton& operator=(const SwappableSingleton&);
+
+        struct State {
+            std::mutex writer;
+            std::atomic<Version*> current{ nullptr };
+        };
+
+        // Deliberately leaked, like the epoch domain: threads still running
+        // at exit, or thread_local destructors, may take a Snapshot after
+        // static destruction, so the current version is never freed
+        static State& GetState() {
+            static State* state = new State();
+            return *state;
+        }
+
+        static void EnsureInitialized() {
+            State& state = GetState();
+            if (!state.current.load(std::memory_order_acquire)) {
+                MakeInitial(state);
+            }
+        }
+
+        // Default-constructs the first version
+        static void MakeInitial(State& state) {
+            std::lock_guard<std::mutex> guard(state.writer);
+            if (!state.current.load(std::memory_order_relaxed)) {
+                state.current.store(new Version{ std::make_shared<const T>() }, std::memory_order_release);
+            }
+        }
+    };
+
+} // namespace dp
+
+#endif // SWAPPABLE_SINGLETON_HPP
@@ -0,0 +1,330 @@
+#ifndef SYNC_PRIMITIVES_HPP
+#define SYNC_PRIMITIVES_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <functional>   // for std::hash
+#include "platform.hpp"
+
+#if defined(__linux__)
+#include <sched.h>      // for sched_getcpu
+#include <climits>      // for INT_MAX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>        // for timespec
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>     // for _mm_pause
+#endif
+
+namespace dp {
+namespace detail {
+
+    // Assumed size of a cache line (destructive interference size)
+    constexpr std::size_t kCacheLineSize = 64;
+
+    // Holds a value alone on its cache line(s), so a frequently written
+    // word (e.g. a lock) cannot falsely share a line with another
+    // singleton's hot read-mostly state
+    template <typename U>
+    struct alignas(kCacheLineSize) CacheLinePadded {
+        U value;
+    };
+
+    // Number of CPUs that sharded state is spread over (at least 1)
+    inline std::size_t CpuCount() {
+#if defined(__linux__)
+        long n = sysconf(_SC_NPROCESSORS_CONF);
+        if (n > 0) {
+            return static_cast<std::size_t>(n);
+        }
+#endif
+        unsigned n2 = std::thread::hardware_concurrency();
+        return n2 ? n2 : 1;
+    }
+
+    // CPU the calling thread is running on; a stable per-thread value
+    // where the platform cannot tell
+    inline std::size_t CurrentCpu() {
+#if defined(__linux__)
+        int cpu = sched_getcpu();
+        if (cpu >= 0) {
+            return static_cast<std::size_t>(cpu);
+        }
+#endif
+        static thread_local std::size_t id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return id;
+    }
+
+    // Hint to the CPU that we are busy-waiting
+    inline void CpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Blocks while word == expected (may return spuriously)
+    inline void WaitOnAddress(std::atomic<std::uint32_t>& word, std::uint32_t expected) {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+        if (word.load(std::memory_order_relaxed) == expected) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+#endif
+    }
+
+    // Wakes one thread blocked in WaitOnAddress on word
+    inline void WakeOne(std::atomic<std::uint32_t>& word) {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+    // Wakes every thread blocked in WaitOnAddress on word
+    inline void WakeAll(std::atomic<std::uint32_t>& word) {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+    // WaitOnAddress for a word in memory shared between processes; also
+    // returns after timeoutMs so the caller can check on the other side
+    inline void WaitOnSharedAddress(std::atomic<std::uint32_t>& word, std::uint32_t expected, int timeoutMs) {
+#if defined(__linux__)
+        timespec timeout{ timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+        if (word.load(std::memory_order_relaxed) == expected) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs < 1 ? 1 : timeoutMs));
+        }
+#endif
+    }
+
+    // Wakes every waiter, in any process, blocked on word
+    inline void WakeAllShared(std::atomic<std::uint32_t>& word) {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+    // Mutex that spins with exponential backoff for a bounded number of
+    // attempts and then parks the thread in the kernel.
+    // State: 0 = unlocked, 1 = locked, 2 = locked with (possible) waiters.
+    class SpinParkMutex {
+    public:
+        static constexpr int kSpinLimit = 64;
+        static constexpr int kMaxBackoff = 64;
+
+        void lock() {
+            std::uint32_t c = 0;
+            if (state_.compare_exchange_strong(c, 1, std::memory_order_acquire)) {
+                return;
+            }
+            LockSlow();
+        }
+
+        void unlock() {
+            if (state_.exchange(0, std::memory_order_release) == 2) {
+                WakeOne(state_);
+            }
+        }
+
+    private:
+        void LockSlow() {
+            int backoff = 1;
+            for (int spin = 0; spin < kSpinLimit; ++spin) {
+                for (int i = 0; i < backoff; ++i) {
+                    CpuRelax();
+                }
+                if (backoff < kMaxBackoff) {
+                    backoff *= 2;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+                std::uint32_t c = 0;
+                if (state_.load(std::memory_order_relaxed) == 0 &&
+                    state_.compare_exchange_strong(c, 1, std::memory_order_acquire)) {
+                    return;
+                }
+            }
+            // Park: mark the lock contended and sleep until it is released
+            while (state_.exchange(2, std::memory_order_acquire) != 0) {
+                WaitOnAddress(state_, 2);
+            }
+        }
+
+        std::atomic<std::uint32_t> state_{ 0 };
+    };
+
+    // Process-wide threading phase read by AdaptiveLockable: the process
+    // counts as single-threaded until EnterMultithreaded()
+    struct ThreadingPhase {
+        std::atomic<bool> multithreaded{ false };
+    };
+
+    // Constant-initialized, so access needs no guard
+    inline ThreadingPhase& Phase() {
+        static ThreadingPhase phase;
+        return phase;
+    }
+
+    // Ends the single-threaded phase; the library calls it before
+    // starting a thread of its own
+    inline void MarkMultithreaded() {
+        Phase().multithreaded.store(true, std::memory_order_release);
+    }
+
+    // Test hook: starts a new single-threaded phase. No other thread may
+    // be using an AdaptiveLockable singleton
+    inline void ResetThreadingPhase() {
+        Phase().multithreaded.store(false, std::memory_order_release);
+    }
+
+    // Reader-writer lock in one 32-bit word: a reader count, a writer bit
+    // and a bit flagging readers parked on the word. Readers only ever
+    // share it, so they never exclude one another; a writer sets the
+    // writer bit to hold off new readers and waits for the count to drain.
+    // Writers must be serialized by the caller.
+    class SharedSpinParkWord {
+    public:
+        static constexpr std::uint32_t kWriter = 1u << 31;
+        static constexpr std::uint32_t kReadersWaiting = 1u << 30;
+        static constexpr std::uint32_t kReaderMask = kReadersWaiting - 1;
+
+        void lock_shared() {
+            for (int spin = 0;; ++spin) {
+                std::uint32_t s = state_.load(std::memory_order_relaxed);
+                if (!(s & kWriter)) {
+                    if (state_.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                        return;
+                    }
+                    continue;
+                }
+                if (spin < SpinParkMutex::kSpinLimit) {
+                    CpuRelax();
+                    continue;
+                }
+                // Park until the writer clears the word
+                if ((s & kReadersWaiting) ||
+                    state_.compare_exchange_weak(s, s | kReadersWaiting, std::memory_order_relaxed)) {
+                    WaitOnAddress(state_, s | kReadersWaiting);
+                }
+            }
+        }
+
+        void unlock_shared() {
+            // A pending writer sleeps until the count changes
+            if (state_.fetch_sub(1, std::memory_order_release) & kWriter) {
+                WakeAll(state_);
+            }
+        }
+
+        void lock() {
+            std::uint32_t s = state_.fetch_or(kWriter, std::memory_order_acquire) | kWriter;
+            while (s & kReaderMask) {
+                WaitOnAddress(state_, s);
+                s = state_.load(std::memory_order_acquire);
+            }
+        }
+
+        void unlock() {
+            if (state_.exchange(0, std::memory_order_release) & kReadersWaiting) {
+                WakeAll(state_);
+            }
+        }
+
+    private:
+        std::atomic<std::uint32_t> state_{ 0 };
+    };
+
+    // Runs an initialization exactly once among concurrent callers without
+    // a mutex: the state word moves from uninitialized to in-progress to
+    // ready, and callers arriving mid-initialization sleep on it (futex).
+    // If the initialization throws, the state rolls back and a waiter (or
+    // a later caller) retries.
+    class OnceFlag {
+    public:
+        bool IsReady() const noexcept {
+            return state_.load(std::memory_order_acquire) == kReady;
+        }
+
+        // Runs f() unless it already completed; returns once it has
+        template <typename F>
+        void Call(F&& f) {
+            for (;;) {
+                std::uint32_t s = kUninitialized;
+                if (state_.compare_exchange_strong(s, kInProgress, std::memory_order_acquire)) {
+#if defined(DP_HAS_EXCEPTIONS)
+                    try {
+                        f();
+                    }
+                    catch (...) {
+                        Finish(kUninitialized);
+                        throw;
+                    }
+#else
+                    f();
+#endif
+                    Finish(kReady);
+                    return;
+                }
+                if (s == kReady) {
+                    return;
+                }
+                // Someone else is running f: flag that we wait, then sleep
+                if (s == kInProgress &&
+                    !state_.compare_exchange_strong(s, kInProgressWaiters, std::memory_order_relaxed)) {
+                    continue;
+                }
+                WaitOnAddress(state_, kInProgressWaiters);
+            }
+        }
+
+        // Makes the next Call() run f again; must not race with Call()
+        void Reset() noexcept {
+            state_.store(kUninitialized, std::memory_order_release);
+        }
+
+    private:
+        static constexpr std::uint32_t kUninitialized = 0;
+        static constexpr std::uint32_t kInProgress = 1;
+        static constexpr std::uint32_t kInProgressWaiters = 2;
+        static constexpr std::uint32_t kReady = 3;
+
+        void Finish(std::uint32_t next) noexcept {
+            if (state_.exchange(next, std::memory_order_release) == kInProgressWaiters) {
+                WakeAll(state_);
+            }
+        }
+
+        std::atomic<std::uint32_t> state_{ kUninitialized };
+    };
+
+} // namespace detail
+} // namespace dp
+
+#endif // SYNC_PRIMITIVES_HPP
@@ -2,7 +2,14 @@
 #define THREADING_POLICY_HPP
 
 #include <mutex>
+#include <stdexcept>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "sync_primitives.hpp"
+#include "policy_traits.hpp"
 
 namespace dp {
 
@@ -23,16 +30,16 @@ namespace dp {
     public:
         class Lock {
         private:
-            static std::mutex mtx_;
+            static detail::CacheLinePadded<std::mutex> mtx_;
         public:
-            Lock() { mtx_.lock(); }
-            ~Lock() { mtx_.unlock(); }
+            Lock() { mtx_.value.lock(); }
+            ~Lock() { mtx_.value.unlock(); }
         };
     };
 
     // Static mutex initialization
     template <typename T>
-    std::mutex ClassLevelLockable<T>::Lock::mtx_;
+    detail::CacheLinePadded<std::mutex> ClassLevelLockable<T>::Lock::mtx_;
 
     // Policy using atomic operations
     template <typename T>
@@ -40,43 +47,478 @@ namespace dp {
     public:
         class Lock {
         private:
-            static std::atomic_flag flag_;
+            static detail::CacheLinePadded<std::atomic_flag> flag_;
         public:
             Lock() {
-                while (flag_.test_and_set(std::memory_order_acquire)) {
+                while (flag_.value.test_and_set(std::memory_order_acquire)) {
                     // Spin-lock
                 }
             }
 
             ~Lock() {
-                flag_.clear(std::memory_order_release);
+                flag_.value.clear(std::memory_order_release);
             }
         };
     };
 
     // Atomic flag initialization
     template <typename T>
-    std::atomic_flag AtomicLockable<T>::Lock::flag_ = ATOMIC_FLAG_INIT;
+    detail::CacheLinePadded<std::atomic_flag> AtomicLockable<T>::Lock::flag_ = { ATOMIC_FLAG_INIT };
 
-    // Policy using thread_local for thread-specific instances
+    // Policy using a bounded spin with exponential backoff, then parking
+    // on a futex, so waiters do not starve the constructing thread
+    template <typename T>
+    class SpinParkLockable {
+    public:
+        class Lock {
+        private:
+            static detail::CacheLinePadded<detail::SpinParkMutex> mtx_;
+        public:
+            Lock() { mtx_.value.lock(); }
+            ~Lock() { mtx_.value.unlock(); }
+        };
+    };
+
+    // Spin-then-park mutex initialization
+    template <typename T>
+    detail::CacheLinePadded<detail::SpinParkMutex> SpinParkLockable<T>::Lock::mtx_;
+
+    // Ends the single-threaded phase: every AdaptiveLockable locks from
+    // now on. Call it before starting the first thread that uses
+    // AdaptiveLockable singletons; the library calls it before starting threads that
+    // build or destroy singletons (Prefetch(), WarmUp, parallel
+    // destruction). There is no way back
+    inline void EnterMultithreaded() {
+        detail::MarkMultithreaded();
+    }
+
+    inline bool IsMultithreaded() {
+        return detail::Phase().multithreaded.load(std::memory_order_acquire);
+    }
+
+    // Policy that skips locking while the process is single-threaded and
+    // uses a spin-then-park mutex once it is not, for programs that build
+    // their singletons before starting any workers. The check is one
+    // relaxed load and a branch that only ever flips once. Starting a
+    // thread that uses these singletons before EnterMultithreaded() is a
+    // data race: the phase is never guessed from which thread is calling,
+    // since a second thread could not tell whether the first is already
+    // inside an unlocked Lock
+    template <typename T>
+    class AdaptiveLockable {
+    public:
+        class Lock {
+        private:
+            static detail::CacheLinePadded<detail::SpinParkMutex> mtx_;
+            bool locked_; // The phase may end while this Lock is held
+        public:
+            Lock() : locked_(DP_LIKELY(detail::Phase().multithreaded.load(std::memory_order_relaxed))) {
+                if (locked_) {
+                    mtx_.value.lock();
+                }
+            }
+
+            ~Lock() {
+                if (locked_) {
+                    mtx_.value.unlock();
+                }
+            }
+
+            Lock(const Lock&) = delete;
+            Lock& operator=(const Lock&) = delete;
+        };
+    };
+
+    // Spin-then-park mutex initialization
+    template <typename T>
+    detail::CacheLinePadded<detail::SpinParkMutex> AdaptiveLockable<T>::Lock::mtx_;
+
+    // Policy using thread_local for thread-specific instances.
+    // This model owns instance storage: Singleton forwards Instance() here, so
+    // each thread gets its own object, reached through a single thread_local
+    // load, and destroyed when that thread exits.
     template <typename T>
     class ThreadLocalSingleton {
     public:
+        static constexpr bool OwnsInstanceStorage = true;
+        static constexpr bool PerThreadInstances = true;
+
         class Lock {
         public:
             Lock() {}
             ~Lock() {}
         };
 
-        static T& Instance() {
+        // Factory supplies Create(args...), Destroy(T*), OnDeadReference()
+        // and the Lifetime policy type;
+        // args are only used if the calling thread has no instance yet
+        template <typename Factory, typename... Args>
+        static T& Instance(Args&&... args) {
+            T* p = Slot<Factory>();
+            if (DP_UNLIKELY(!p)) {
+                p = MakeInstance<Factory>(std::forward<Args>(args)...);
+            }
+            return *p;
+        }
+
+        // Constructs the calling thread's instance from args; raises
+        // std::logic_error if the thread already has one
+        template <typename Factory, typename... Args>
+        static T& Emplace(Args&&... args) {
+            if (Slot<Factory>()) {
+                detail::Raise<std::logic_error>("Singleton instance already exists");
+            }
+            return *MakeInstance<Factory>(std::forward<Args>(args)...);
+        }
+
+        // Calling thread's instance, or nullptr; never creates
+        template <typename Factory>
+        static T* Peek() {
+            return Slot<Factory>();
+        }
+
+        // Destroys the calling thread's instance now instead of at thread exit
+        template <typename Factory>
+        static void Destroy(bool markDestroyed = true) {
+            if (T* p = Slot<Factory>()) {
+                Slot<Factory>() = nullptr;
+                Factory::Destroy(p);
+                if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                    Destroyed<Factory>() = markDestroyed;
+                }
+            }
+        }
+
+    private:
+        // Trivial and constant-initialized, so access needs no TLS guard
+        template <typename Factory>
+        static T*& Slot() {
             static thread_local T* instance = nullptr;
-            if (!instance) {
-                instance = new T();
+            return instance;
+        }
+
+        template <typename Factory>
+        static bool& Destroyed() {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        // Destroys the calling thread's instance at thread exit
+        template <typename Factory>
+        struct Reaper {
+            ~Reaper() { Destroy<Factory>(); }
+        };
+
+        template <typename Factory, typename... Args>
+        DP_NOINLINE DP_COLD static T* MakeInstance(Args&&... args) {
+            if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                if (Destroyed<Factory>()) {
+                    Factory::OnDeadReference();
+                    Destroyed<Factory>() = false;
+                }
             }
-            return *instance;
+            T* p = Factory::Create(std::forward<Args>(args)...);
+            Slot<Factory>() = p;
+            static thread_local Reaper<Factory> reaper;
+            (void)reaper;
+            return p;
         }
     };
 
+    // Most instances a RecycledThreadLocal<T> pool keeps; specialize
+    // value to size the pool for T
+    template <typename T>
+    struct ThreadLocalPoolCapacity {
+        static constexpr std::size_t value = 16;
+    };
+
+    namespace detail {
+        // Detects an ADL-visible `void OnRecycle(T&)`, called before an
+        // instance is pooled (e.g. to clear per-request state)
+        template <typename T, typename = void>
+        struct HasRecycleHook : std::false_type {};
+
+        template <typename T>
+        struct HasRecycleHook<T, std::void_t<decltype(OnRecycle(std::declval<T&>()))>>
+            : std::true_type {};
+    } // namespace detail
+
+    // Per-thread instances like ThreadLocalSingleton, but when a thread
+    // exits its instance goes to a bounded pool instead of being
+    // destroyed, and the next thread to need one takes it from there: a
+    // churning thread pool reuses built objects (with their warm
+    // buffers) instead of creating one per thread. Instances come from
+    // and, once the pool is full, go back to the creation policy. A
+    // recycled instance keeps its state apart from what OnRecycle(T&)
+    // resets. Instance(args...) and Emplace(args...) with arguments always
+    // construct a new instance from them rather than take a pooled one.
+    template <typename T>
+    class RecycledThreadLocal {
+    public:
+        static constexpr bool OwnsInstanceStorage = true;
+        static constexpr bool PerThreadInstances = true;
+
+        class Lock {
+        public:
+            Lock() {}
+            ~Lock() {}
+        };
+
+        template <typename Factory, typename... Args>
+        static T& Instance(Args&&... args) {
+            T* p = Slot<Factory>();
+            if (DP_UNLIKELY(!p)) {
+                p = MakeInstance<Factory>(sizeof...(Args) == 0, std::forward<Args>(args)...);
+            }
+            return *p;
+        }
+
+        // Constructs the calling thread's instance from args; raises
+        // std::logic_error if the thread already has one
+        template <typename Factory, typename... Args>
+        static T& Emplace(Args&&... args) {
+            if (Slot<Factory>()) {
+                detail::Raise<std::logic_error>("Singleton instance already exists");
+            }
+            return *MakeInstance<Factory>(false, std::forward<Args>(args)...);
+        }
+
+        template <typename Factory>
+        static T* Peek() {
+            return Slot<Factory>();
+        }
+
+        // Returns the calling thread's instance to the pool now instead of at thread exit
+        template <typename Factory>
+        static void Destroy(bool markDestroyed = true) {
+            if (T* p = Slot<Factory>()) {
+                Slot<Factory>() = nullptr;
+                Recycle<Factory>(p);
+                if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                    Destroyed<Factory>() = markDestroyed;
+                }
+            }
+        }
+
+    private:
+        static constexpr std::size_t kCapacity = ThreadLocalPoolCapacity<T>::value;
+
+        // Fixed array, so pooling never allocates. Never destroyed: a
+        // thread exiting during or after static destruction (detached, or
+        // joined from a static destructor) may still recycle into it
+        template <typename Factory>
+        struct Pool {
+            detail::SpinParkMutex mtx;
+            std::size_t count = 0;
+            bool closed = false; // Set at exit; later instances go back to the creation policy
+            T* free[kCapacity > 0 ? kCapacity : 1] = {};
+        };
+
+        // Destroys the pooled instances at exit and closes the pool
+        template <typename Factory>
+        struct PoolCloser {
+            ~PoolCloser() {
+                Pool<Factory>& pool = GetPool<Factory>();
+                std::lock_guard<detail::SpinParkMutex> guard(pool.mtx);
+                pool.closed = true;
+                for (std::size_t i = 0; i < pool.count; ++i) {
+                    Factory::Destroy(pool.free[i]);
+                }
+                pool.count = 0;
+            }
+        };
+
+        // Trivially destructible and constant-initialized, so it stays valid
+        // to the end of the process
+        template <typename Factory>
+        static Pool<Factory>& GetPool() {
+            static Pool<Factory> pool;
+            return pool;
+        }
+
+        template <typename Factory>
+        static T*& Slot() {
+            static thread_local T* instance = nullptr;
+            return instance;
+        }
+
+        template <typename Factory>
+        static bool& Destroyed() {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        template <typename Factory>
+        struct Reaper {
+            ~Reaper() { Destroy<Factory>(); }
+        };
+
+        template <typename Factory>
+        static void Recycle(T* p) {
+            if constexpr (detail::HasRecycleHook<T>::value) {
+                OnRecycle(*p);
+            }
+            Pool<Factory>& pool = GetPool<Factory>();
+            {
+                std::lock_guard<detail::SpinParkMutex> guard(pool.mtx);
+                if (!pool.closed && pool.count < kCapacity) {
+                    pool.free[pool.count++] = p;
+                    return;
+                }
+            }
+            Factory::Destroy(p);
+        }
+
+        template <typename Factory>
+        static T* TakePooled() {
+            Pool<Factory>& pool = GetPool<Factory>();
+            std::lock_guard<detail::SpinParkMutex> guard(pool.mtx);
+            return pool.count ? pool.free[--pool.count] : nullptr;
+        }
+
+        template <typename Factory, typename... Args>
+        DP_NOINLINE DP_COLD static T* MakeInstance(bool mayReuse, Args&&... args) {
+            if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                if (Destroyed<Factory>()) {
+                    Factory::OnDeadReference();
+                    Destroyed<Factory>() = false;
+                }
+            }
+            static PoolCloser<Factory> closer; // Registered before any instance can be pooled
+            (void)closer;
+            T* p = mayReuse ? TakePooled<Factory>() : nullptr;
+            if (!p) {
+                p = Factory::Create(std::forward<Args>(args)...);
+            }
+            Slot<Factory>() = p;
+            static thread_local Reaper<Factory> reaper;
+            (void)reaper;
+            return p;
+        }
+    };
+
+    // Policy initializing the process-wide instance exactly once, with no
+    // mutex on the creation path. A 32-bit state word (detail::OnceFlag) moves from
+    // uninitialized to in-progress to ready; threads arriving while the
+    // instance is being built sleep on the word (futex) until the builder
+    // finishes. Once ready, Instance() is a single acquire load. If the
+    // constructor throws, the state rolls back to uninitialized and one of
+    // the waiters retries. This model owns instance storage.
+    template <typename T>
+    class OnceInit {
+    public:
+        static constexpr bool OwnsInstanceStorage = true;
+
+        // Creation never takes it; offered for callers serializing other work on T
+        class Lock {
+        private:
+            static detail::CacheLinePadded<detail::SpinParkMutex> mtx_;
+        public:
+            Lock() { mtx_.value.lock(); }
+            ~Lock() { mtx_.value.unlock(); }
+        };
+
+        // Factory supplies Create(args...), Destroy(T*), OnDeadReference(),
+        // ScheduleDestruction(T*) and the Lifetime policy type
+        template <typename Factory, typename... Args>
+        static T& Instance(Args&&... args) {
+            T* p = GetControl<Factory>().instance.load(std::memory_order_acquire);
+            if (DP_UNLIKELY(!p)) {
+                p = MakeInstance<Factory>(false, std::forward<Args>(args)...);
+            }
+            return *p;
+        }
+
+        // Constructs the instance from args; raises std::logic_error unless
+        // this call is the one that built it, even when racing another
+        template <typename Factory, typename... Args>
+        static T& Emplace(Args&&... args) {
+            return *MakeInstance<Factory>(true, std::forward<Args>(args)...);
+        }
+
+        template <typename Factory>
+        static T* Peek() {
+            return GetControl<Factory>().instance.load(std::memory_order_acquire);
+        }
+
+        // Returns the state to uninitialized; must not race with Instance()
+        template <typename Factory>
+        static void Destroy(bool markDestroyed = true) {
+            Control& control = GetControl<Factory>();
+            if (T* p = control.instance.exchange(nullptr, std::memory_order_acq_rel)) {
+                control.once.Reset();
+                Factory::Destroy(p);
+                if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                    control.destroyed = markDestroyed;
+                }
+            }
+        }
+
+    private:
+        // On lines of its own, away from other singletons' state
+        struct alignas(detail::kCacheLineSize) Control {
+            std::atomic<T*> instance{ nullptr };
+            detail::OnceFlag once;
+            bool destroyed = false; // Only accessed inside once
+        };
+
+        // Constant-initialized, so access needs no guard
+        template <typename Factory>
+        static Control& GetControl() {
+            static Control control;
+            return control;
+        }
+
+        template <typename Factory, typename... Args>
+        DP_NOINLINE DP_COLD static T* MakeInstance(bool mustCreate, Args&&... args) {
+            Control& control = GetControl<Factory>();
+            bool created = false;
+            control.once.Call([&]() {
+                if constexpr (DestroysInstance<typename Factory::Lifetime>::value) {
+                    if (control.destroyed) {
+                        Factory::OnDeadReference();
+                        control.destroyed = false;
+                    }
+                }
+                T* p = Factory::Create(std::forward<Args>(args)...);
+                control.instance.store(p, std::memory_order_release);
+                Factory::ScheduleDestruction(p);
+                created = true;
+                });
+            if (mustCreate && !created) {
+                detail::Raise<std::logic_error>("Singleton instance already exists");
+            }
+            return control.instance.load(std::memory_order_acquire);
+        }
+    };
+
+    // Spin-then-park mutex initialization
+    template <typename T>
+    detail::CacheLinePadded<detail::SpinParkMutex> OnceInit<T>::Lock::mtx_;
+
+    // Detects threading models that manage instance storage themselves
+    template <typename Model, typename = void>
+    struct OwnsInstanceStorage : std::false_type {};
+
+    template <typename Model>
+    struct OwnsInstanceStorage<Model, std::void_t<decltype(Model::OwnsInstanceStorage)>>
+        : std::bool_constant<Model::OwnsInstanceStorage> {};
+
+    // Detects threading models giving each thread its own instance
+    template <typename Model, typename = void>
+    struct HasPerThreadInstances : std::false_type {};
+
+    template <typename Model>
+    struct HasPerThreadInstances<Model, std::void_t<decltype(Model::PerThreadInstances)>>
+        : std::bool_constant<Model::PerThreadInstances> {};
+
+    // True for threading models that do no synchronization at all
+    template <typename Model>
+    struct IsSingleThreaded : std::false_type {};
+
+    template <typename T>
+    struct IsSingleThreaded<SingleThreaded<T>> : std::true_type {};
+
     // Set default threading model
     template <typename T>
     using DefaultThreadingModel = ClassLevelLockable<T>;
@@ -0,0 +1,268 @@
+#ifndef WARM_UP_HPP
+#define WARM_UP_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "platform.hpp"
+#include "sync_primitives.hpp"
+
+namespace dp {
+
+    // Lists the singletons a registered singleton must be built after
+    template <typename... Singletons>
+    struct DependsOn {};
+
+    namespace detail {
+
+        // Unique per-type key, stable across translation units
+        template <typename S>
+        const void* WarmUpKey() {
+            static const char key = 0;
+            return &key;
+        }
+
+        template <typename S>
+        void WarmUpInstance() {
+            (void)S::Instance();
+        }
+
+        // Dependency graph of singletons built by WarmUp()
+        class WarmUpRegistry {
+        public:
+            static WarmUpRegistry& Get() {
+                static WarmUpRegistry registry;
+                return registry;
+            }
+
+            // Adds a node with no dependencies unless one exists already
+            void AddNode(const void* key, void (*build)()) {
+                std::lock_guard<std::mutex> guard(mtx_);
+                FindOrAdd(key, build);
+            }
+
+            void AddDependency(const void* key, const void* dependency) {
+                std::lock_guard<std::mutex> guard(mtx_);
+                Node& node = nodes_[IndexOf(key)];
+                if (std::find(node.deps.begin(), node.deps.end(), dependency) == node.deps.end()) {
+                    node.deps.push_back(dependency);
+                }
+            }
+
+            void Run(unsigned threads) {
+                std::vector<Node> nodes;
+                {
+                    std::lock_guard<std::mutex> guard(mtx_);
+                    nodes = nodes_;
+                }
+                Schedule schedule(nodes);
+                threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(nodes.size())));
+
+                std::vector<std::thread> workers;
+                if (threads > 1) {
+                    MarkMultithreaded();
+                }
+                for (unsigned t = 1; t < threads; ++t) {
+                    workers.emplace_back([&schedule]() { schedule.Work(); });
+                }
+                schedule.Work();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                schedule.RethrowIfFailed();
+            }
+
+        private:
+            struct Node {
+                const void* key;
+                void (*build)();
+                std::vector<const void*> deps;
+            };
+
+            // Kahn's algorithm executed by a set of worker threads
+            class Schedule {
+            public:
+                explicit Schedule(const std::vector<Node>& nodes)
+                    : nodes_(nodes), pending_(nodes.size(), 0), dependents_(nodes.size()) {
+                    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+                        for (const void* dep : nodes_[i].deps) {
+                            dependents_[IndexIn(dep)].push_back(i);
+                            ++pending_[i];
+                        }
+                    }
+                    CheckAcyclic();
+                    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+                        if (pending_[i] == 0) {
+                            ready_.push_back(i);
+                        }
+                    }
+                }
+
+                void Work() {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    for (;;) {
+                        cv_.wait(lock, [this]() { return Finished() || (!error_ && !ready_.empty()); });
+                        if (Finished()) {
+                            return;
+                        }
+                        std::size_t i = ready_.front();
+                        ready_.pop_front();
+                        ++running_;
+
+                        lock.unlock();
+                        std::exception_ptr error;
+#if defined(DP_HAS_EXCEPTIONS)
+                        try {
+                            nodes_[i].build();
+                        }
+                        catch (...) {
+                            error = std::current_exception();
+                        }
+#else
+                        nodes_[i].build();
+#endif
+                        lock.lock();
+
+                        --running_;
+                        ++done_;
+                        if (error) {
+                            if (!error_) {
+                                error_ = error;
+                            }
+                        }
+                        else {
+                            for (std::size_t d : dependents_[i]) {
+                                if (--pending_[d] == 0) {
+                                    ready_.push_back(d);
+                                }
+                            }
+                        }
+                        cv_.notify_all();
+                    }
+                }
+
+                void RethrowIfFailed() {
+#if defined(DP_HAS_EXCEPTIONS)
+                    if (error_) {
+                        std::rethrow_exception(error_);
+                    }
+#endif
+                }
+
+            private:
+                // Everything built, or a failure and nothing left in flight
+                bool Finished() const {
+                    return done_ == nodes_.size() || (error_ && running_ == 0);
+                }
+
+                std::size_t IndexIn(const void* key) const {
+                    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+                        if (nodes_[i].key == key) {
+                            return i;
+                        }
+                    }
+                    detail::Raise<std::logic_error>("WarmUp dependency is not registered");
+                }
+
+                void CheckAcyclic() const {
+                    std::vector<std::size_t> pending = pending_;
+                    std::vector<std::size_t> stack;
+                    for (std::size_t i = 0; i < pending.size(); ++i) {
+                        if (pending[i] == 0) {
+                            stack.push_back(i);
+                        }
+                    }
+                    std::size_t visited = 0;
+                    while (!stack.empty()) {
+                        std::size_t i = stack.back();
+                        stack.pop_back();
+                        ++visited;
+                        for (std::size_t d : dependents_[i]) {
+                            if (--pending[d] == 0) {
+                                stack.push_back(d);
+                            }
+                        }
+                    }
+                    if (visited != nodes_.size()) {
+                        detail::Raise<std::logic_error>("Cyclic singleton dependencies detected");
+                    }
+                }
+
+                const std::vector<Node>& nodes_;
+                std::vector<std::size_t> pending_;
+                std::vector<std::vector<std::size_t>> dependents_;
+                std::deque<std::size_t> ready_;
+                std::size_t running_ = 0;
+                std::size_t done_ = 0;
+                std::exception_ptr error_;
+                std::mutex mtx_;
+                std::condition_variable cv_;
+            };
+
+            Node& FindOrAdd(const void* key, void (*build)()) {
+                for (Node& node : nodes_) {
+                    if (node.key == key) {
+                        return node;
+                    }
+                }
+                nodes_.push_back(Node{ key, build, {} });
+                return nodes_.back();
+            }
+
+            std::size_t IndexOf(const void* key) const {
+                for (std::size_t i = 0; i < nodes_.size(); ++i) {
+                    if (nodes_[i].key == key) {
+                        return i;
+                    }
+                }
+                detail::Raise<std::logic_error>("Singleton is not registered for WarmUp");
+            }
+
+            std::vector<Node> nodes_;
+            std::mutex mtx_;
+        };
+
+        template <typename S, typename Deps>
+        struct WarmUpRegistration;
+
+        template <typename S, typename... Ds>
+        struct WarmUpRegistration<S, DependsOn<Ds...>> {
+            static bool Register() {
+                WarmUpRegistry& registry = WarmUpRegistry::Get();
+                registry.AddNode(WarmUpKey<S>(), &WarmUpInstance<S>);
+                (registry.AddNode(WarmUpKey<Ds>(), &WarmUpInstance<Ds>), ...);
+                (registry.AddDependency(WarmUpKey<S>(), WarmUpKey<Ds>()), ...);
+                return true;
+            }
+        };
+
+    } // namespace detail
+
+    // Registers singleton S (any type with a static Instance()) for WarmUp().
+    // Dependencies are registered too if they are not already. Returns true
+    // so it can initialize a namespace-scope constant:
+    //   const bool poolRegistered = dp::RegisterForWarmUp<Pool, dp::DependsOn<Config, Log>>();
+    template <typename S, typename Deps = DependsOn<>>
+    bool RegisterForWarmUp() {
+        return detail::WarmUpRegistration<S, Deps>::Register();
+    }
+
+    // Builds every registered singleton, running independent ones
+    // concurrently on up to `threads` threads (the caller is one of them)
+    // and each one only after all of its dependencies. Construction goes
+    // through the usual Instance() path, so creation and lifetime policies
+    // apply unchanged. Rethrows the first constructor exception once the
+    // work in flight has finished; throws std::logic_error on a cycle.
+    inline void WarmUp(unsigned threads = std::thread::hardware_concurrency()) {
+        detail::WarmUpRegistry::Get().Run(threads);
+    }
+
+} // namespace dp
+
+#endif // WARM_UP_HPP
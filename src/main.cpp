@@ -1,7 +1,11 @@
 #include <iostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include "../include/singleton.hpp"
+#include "../include/access_policy.hpp"
+#include "../include/config_table.hpp"
+#include "../include/async_logger.hpp"
 
 // Example class for logging
 class Logger {
@@ -18,6 +22,9 @@ public:
 class Configuration {
 public:
     Configuration() { std::cout << "Configuration created\n"; }
+    explicit Configuration(std::unordered_map<std::string, std::string> data) : data_(std::move(data)) {
+        std::cout << "Configuration created with " << data_.size() << " values\n";
+    }
     ~Configuration() { std::cout << "Configuration destroyed\n"; }
 
     void setValue(const std::string& key, const std::string& value) {
@@ -37,9 +44,10 @@ private:
 // 1. Basic logger with default policies
 using BasicLogger = dp::Singleton<Logger>;
 
-// 2. Thread-safe configuration using PhoenixSingleton and shared_ptr
+// 2. Thread-safe configuration using PhoenixSingleton and shared_ptr;
+// reads and writes after construction go through a reader-writer lock
 using SafeConfig = dp::Singleton<
-    Configuration,
+    dp::Guarded<Configuration>,
     dp::CreateUsingSharedPtr,
     dp::PhoenixSingleton,
     dp::ClassLevelLockable
@@ -57,10 +65,13 @@ using PersistentLogger = dp::Singleton<
 using ThreadLocalLogger = dp::Singleton<
     Logger,
     dp::CreateUsingNew,
-    dp::NoDestroy,
+    dp::DestroyAtThreadExit,
     dp::ThreadLocalSingleton
 >;
 
+// 5. Asynchronous logger: Log() only queues; the destructor drains the queue
+using FastLogger = dp::Singleton<dp::AsyncLogger>;
+
 int main() {
     std::cout << "--- Demonstrating Singleton with orthogonal policies ---\n\n";
 
@@ -70,11 +81,29 @@ int main() {
 
     // Using the configuration singleton
     std::cout << "\nUsing SafeConfig:\n";
-    SafeConfig::Instance().setValue("server", "localhost");
-    SafeConfig::Instance().setValue("port", "8080");
-
-    std::cout << "Server: " << SafeConfig::Instance().getValue("server") << std::endl;
-    std::cout << "Port: " << SafeConfig::Instance().getValue("port") << std::endl;
+    // Built once from its initial values instead of default-constructed and then set
+    SafeConfig::Emplace(std::unordered_map<std::string, std::string>{
+        { "server", "localhost" },
+        { "port", "8080" }
+    });
+
+    std::thread updater([]() { SafeConfig::Write()->setValue("port", "8443"); });
+    std::cout << "Server: " << SafeConfig::Read()->getValue("server") << std::endl;
+    updater.join();
+    std::cout << "Port: " << SafeConfig::Read()->getValue("port") << std::endl;
+
+    // Using the lock-free configuration registry
+    std::cout << "\nUsing ConfigRegistry:\n";
+    dp::ConfigRegistry::Modify([](dp::ConfigTable::Builder& config) {
+        config.Set("server", "localhost").Set("port", "8080");
+    });
+    {
+        // Lookups return views into the current version; no copies
+        auto config = dp::ConfigRegistry::Read();
+        std::cout << "Server: " << config->Get("server") << std::endl;
+        std::cout << "Port: " << config->Get("port") << std::endl;
+        std::cout << "Timeout: " << config->Get("timeout", "30s") << std::endl;
+    }
 
     // Using the persistent logger
     std::cout << "\nUsing PersistentLogger:\n";
@@ -83,6 +112,17 @@ int main() {
     // Using the thread-local logger
     std::cout << "\nUsing ThreadLocalLogger:\n";
     ThreadLocalLogger::Instance().log("Message from main thread");
+    std::thread worker([]() {
+        // Gets its own Logger, destroyed when this thread exits
+        ThreadLocalLogger::Instance().log("Message from worker thread");
+    });
+    worker.join();
+
+    // Using the asynchronous logger
+    std::cout << "\nUsing FastLogger:" << std::endl;
+    FastLogger::Instance().Log("LOG: Queued without a synchronous flush");
+    FastLogger::Instance().Log("LOG: Written by the background thread");
+    FastLogger::Instance().Flush();
 
     // Using the basic logger again
     std::cout << "\nUsing BasicLogger again:\n";
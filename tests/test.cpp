@@ -1,11 +1,36 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_session.hpp>
+#include <algorithm>
 #include <iostream>
 #include <thread>
+#include <chrono>
 #include <vector>
 #include <mutex>
 #include <sstream>
+#include <cstdint>
+#include <atomic>
 #include "../include/singleton.hpp"
+#include "../include/eager_singleton.hpp"
+#include "../include/warm_up.hpp"
+#include "../include/sharded_singleton.hpp"
+#include "../include/numa_policy.hpp"
+#include "../include/swappable_singleton.hpp"
+#include "../include/config_table.hpp"
+#include "../include/async_logger.hpp"
+#include "../include/arena_policy.hpp"
+#include "../include/multiton.hpp"
+#include "../include/mapped_policy.hpp"
+#include "../include/shared_memory_policy.hpp"
+#include "../include/access_policy.hpp"
+#include <cstdio>
+#include <csignal>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // for O_NONBLOCK
+#include <sys/wait.h>   // for waitpid in tests that fork
+#include <unistd.h>
+#endif
 
 // Global mutex for thread-safe console output
 std::mutex cout_mutex;
@@ -43,6 +68,50 @@ private:
 
 int TestSingleton::counter_ = 0;
 
+// Set once main() starts, to tell static initialization apart from runtime
+bool mainStarted = false;
+
+// Test classes for eager singletons
+struct EagerProbe {
+    EagerProbe() : builtBeforeMain(!mainStarted) {}
+    bool builtBeforeMain;
+};
+
+struct DeferredProbe {
+    DeferredProbe() { ++constructions; }
+    static int constructions;
+};
+
+int DeferredProbe::constructions = 0;
+
+// Test class for cached instance references
+struct RefProbe {
+    RefProbe() { ++alive; }
+    ~RefProbe() { --alive; }
+    int value = 7;
+    static int alive;
+};
+
+int RefProbe::alive = 0;
+
+// Test classes for dependency-ordered warm-up; each records its build order
+std::atomic<int> warmUpSequence{ 0 };
+
+template <int N>
+struct WarmUpProbe {
+    WarmUpProbe() : order(warmUpSequence.fetch_add(1)) {}
+    int order;
+};
+
+using WarmBase = dp::Singleton<WarmUpProbe<0>>;
+using WarmLeft = dp::Singleton<WarmUpProbe<1>>;
+using WarmRight = dp::Singleton<WarmUpProbe<2>>;
+using WarmTop = dp::Singleton<WarmUpProbe<3>>;
+
+const bool warmTopRegistered = dp::RegisterForWarmUp<WarmTop, dp::DependsOn<WarmLeft, WarmRight>>();
+const bool warmLeftRegistered = dp::RegisterForWarmUp<WarmLeft, dp::DependsOn<WarmBase>>();
+const bool warmRightRegistered = dp::RegisterForWarmUp<WarmRight, dp::DependsOn<WarmBase>>();
+
 // Define different singleton types for testing
 using SingleThreadedTest = dp::Singleton<
     TestSingleton,
@@ -65,6 +134,27 @@ using AtomicTest = dp::Singleton<
     dp::AtomicLockable
 >;
 
+using SpinParkTest = dp::Singleton<
+    TestSingleton,
+    dp::CreateUsingNew,
+    dp::DefaultLifetime,
+    dp::SpinParkLockable
+>;
+
+using StaticStorageTest = dp::Singleton<
+    TestSingleton,
+    dp::CreateStatic,
+    dp::DefaultLifetime,
+    dp::ClassLevelLockable
+>;
+
+using ThreadLocalTest = dp::Singleton<
+    TestSingleton,
+    dp::CreateUsingNew,
+    dp::DestroyAtThreadExit,
+    dp::ThreadLocalSingleton
+>;
+
 // Test for single instance property
 TEST_CASE("Singleton creates only one instance", "[singleton]") {
     thread_safe_cout("\n[TEST] Starting single-threaded test");
@@ -193,6 +283,1666 @@ TEST_CASE("Singleton with atomic locking works correctly", "[singleton][atomic]"
     thread_safe_cout("[TEST] Atomic locking test completed");
 }
 
+// Test for spin-then-park locking
+TEST_CASE("Singleton with spin-then-park locking works correctly", "[singleton][spinpark]") {
+    thread_safe_cout("\n[TEST] Starting spin-then-park locking test");
+
+    int initialCount = TestSingleton::getCounter();
+
+    SECTION("Spin-then-park instance uniqueness") {
+        const int NUM_THREADS = 16;
+        std::vector<std::thread> threads;
+        std::vector<TestSingleton*> seen(NUM_THREADS, nullptr);
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([i, &seen]() {
+                seen[i] = &SpinParkTest::Instance();
+                });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (TestSingleton* p : seen) {
+            REQUIRE(p == seen.front());
+        }
+        REQUIRE(TestSingleton::getCounter() == initialCount + 1);
+    }
+
+    thread_safe_cout("[TEST] Spin-then-park locking test completed");
+}
+
+// Test for static-storage creation
+TEST_CASE("Singleton created in static storage", "[singleton][static]") {
+    thread_safe_cout("\n[TEST] Starting static storage test");
+
+    int initialCount = TestSingleton::getCounter();
+
+    SECTION("Static storage instance uniqueness") {
+        TestSingleton& instance1 = StaticStorageTest::Instance();
+        TestSingleton& instance2 = StaticStorageTest::Instance();
+
+        REQUIRE(&instance1 == &instance2);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(&instance1) % alignof(TestSingleton) == 0);
+        REQUIRE(TestSingleton::getCounter() == initialCount + 1);
+    }
+
+    thread_safe_cout("[TEST] Static storage test completed");
+}
+
+// Test for per-thread instances
+TEST_CASE("Thread-local singleton gives each thread its own instance", "[singleton][threadlocal]") {
+    thread_safe_cout("\n[TEST] Starting thread-local test");
+
+    int initialCount = TestSingleton::getCounter();
+
+    SECTION("Per-thread instances are distinct and destroyed at thread exit") {
+        TestSingleton* mainInstance = &ThreadLocalTest::Instance();
+        REQUIRE(mainInstance == &ThreadLocalTest::Instance());
+        REQUIRE(TestSingleton::getCounter() == initialCount + 1);
+
+        TestSingleton* workerInstance = nullptr;
+        int countInWorker = 0;
+        std::thread worker([&]() {
+            workerInstance = &ThreadLocalTest::Instance();
+            countInWorker = TestSingleton::getCounter();
+            });
+        worker.join();
+
+        thread_safe_cout("[TEST] Checking that the worker got a different instance");
+        REQUIRE(workerInstance != mainInstance);
+        REQUIRE(countInWorker == initialCount + 2);
+
+        thread_safe_cout("[TEST] Checking that the worker instance was destroyed at thread exit");
+        REQUIRE(TestSingleton::getCounter() == initialCount + 1);
+    }
+
+    thread_safe_cout("[TEST] Thread-local test completed");
+}
+
+// Test for cached instance references
+TEST_CASE("Singleton::Ref caches the instance", "[singleton][ref]") {
+    thread_safe_cout("\n[TEST] Starting Singleton::Ref test");
+
+    SECTION("Ref resolves to the instance") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::NoDestroy, dp::SingleThreaded>;
+        S::Ref ref;
+        REQUIRE(ref.Get() == &S::Instance());
+        REQUIRE(ref->value == 7);
+    }
+
+#ifndef NDEBUG
+    SECTION("Debug Ref re-resolves a Phoenix singleton after destruction") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::PhoenixSingleton, dp::ClassLevelLockable>;
+        S::Ref ref;
+        int aliveBefore = RefProbe::alive;
+
+        dp::detail::SingletonAccess<S>::Destroy();
+        REQUIRE(RefProbe::alive == aliveBefore - 1);
+
+        REQUIRE(ref->value == 7);
+        REQUIRE(RefProbe::alive == aliveBefore);
+        REQUIRE(ref.Get() == &S::Instance());
+    }
+
+    SECTION("Debug Ref reports a dead reference with DefaultLifetime") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::DefaultLifetime, dp::ClassLevelLockable>;
+        S::Ref ref;
+
+        dp::detail::SingletonAccess<S>::Destroy();
+        REQUIRE_THROWS_AS(ref->value, std::logic_error);
+    }
+#endif
+
+    thread_safe_cout("[TEST] Singleton::Ref test completed");
+}
+
+// Test for dependency-ordered warm-up
+TEST_CASE("WarmUp builds registered singletons in dependency order", "[singleton][warmup]") {
+    thread_safe_cout("\n[TEST] Starting warm-up test");
+
+    REQUIRE(warmTopRegistered);
+    REQUIRE(warmLeftRegistered);
+    REQUIRE(warmRightRegistered);
+
+    dp::WarmUp(4);
+
+    int base = WarmBase::Instance().order;
+    int left = WarmLeft::Instance().order;
+    int right = WarmRight::Instance().order;
+    int top = WarmTop::Instance().order;
+
+    thread_safe_cout("[TEST] Checking that every singleton was built after its dependencies");
+    REQUIRE(base < left);
+    REQUIRE(base < right);
+    REQUIRE(left < top);
+    REQUIRE(right < top);
+    REQUIRE(warmUpSequence.load() == 4);
+
+    thread_safe_cout("[TEST] Warm-up test completed");
+}
+
+// Test for longevity-ordered destruction
+std::vector<int> destructionOrder;
+std::mutex destructionOrderMutex;
+
+template <int N>
+void RecordDestruction() {
+    std::lock_guard<std::mutex> lock(destructionOrderMutex);
+    destructionOrder.push_back(N);
+}
+
+struct LongLived {};
+unsigned int GetLongevity(LongLived*) { return 10; }
+
+TEST_CASE("Lifetime tracker destroys in longevity order", "[singleton][longevity]") {
+    thread_safe_cout("\n[TEST] Starting longevity test");
+
+    SECTION("Lower longevity first, LIFO among equals") {
+        destructionOrder.clear();
+        dp::detail::LifetimeTracker tracker;
+        tracker.Add(5, &RecordDestruction<1>);
+        tracker.Add(1, &RecordDestruction<2>);
+        tracker.Add(5, &RecordDestruction<3>);
+        tracker.Add(3, &RecordDestruction<4>);
+        tracker.DestroyAll();
+
+        REQUIRE(destructionOrder == std::vector<int>{ 2, 4, 3, 1 });
+    }
+
+    SECTION("Equal longevities may run in parallel, batches stay ordered") {
+        destructionOrder.clear();
+        dp::detail::LifetimeTracker tracker;
+        tracker.SetParallel(true);
+        tracker.Add(2, &RecordDestruction<1>);
+        tracker.Add(2, &RecordDestruction<2>);
+        tracker.Add(2, &RecordDestruction<3>);
+        tracker.Add(7, &RecordDestruction<4>);
+        tracker.DestroyAll();
+
+        REQUIRE(destructionOrder.size() == 4);
+        REQUIRE(destructionOrder.back() == 4);
+    }
+
+    SECTION("SingletonWithLongevity finds GetLongevity by ADL") {
+        using S = dp::Singleton<LongLived, dp::CreateUsingNew, dp::SingletonWithLongevity>;
+        REQUIRE(&S::Instance() == &S::Instance());
+    }
+
+    thread_safe_cout("[TEST] Longevity test completed");
+}
+
+// Test for flush-only exit
+struct FlushProbe {
+    int flushes = 0;
+};
+void FlushOnExit(FlushProbe& probe) { ++probe.flushes; }
+
+// Flushes end the process with a marker status; only the first is
+// opted into flushing at quick_exit
+struct QuickFlushProbe {};
+void FlushOnExit(QuickFlushProbe&) { std::_Exit(42); }
+struct ExitOnlyFlushProbe {};
+void FlushOnExit(ExitOnlyFlushProbe&) { std::_Exit(43); }
+
+namespace dp {
+    template <>
+    struct FlushOnQuickExit<QuickFlushProbe> {
+        static constexpr bool value = true;
+    };
+}
+
+TEST_CASE("FastExit flushes without destroying", "[singleton][fastexit]") {
+    thread_safe_cout("\n[TEST] Starting fast-exit test");
+
+    using S = dp::Singleton<FlushProbe, dp::CreateUsingNew, dp::FastExit>;
+    FlushProbe& probe = S::Instance();
+    REQUIRE(probe.flushes == 0);
+
+    dp::FastExit<FlushProbe>::FlushNow();
+    REQUIRE(probe.flushes == 1);
+    REQUIRE(&S::Instance() == &probe);
+
+    // A second instance of the same T cannot take over the flush target
+    using Other = dp::Singleton<FlushProbe, dp::CreateUsingNew, dp::FastExit, dp::SpinParkLockable>;
+    REQUIRE_THROWS_AS(Other::Instance(), std::logic_error);
+    dp::FastExit<FlushProbe>::FlushNow();
+    REQUIRE(probe.flushes == 2);
+
+#if defined(__unix__)
+    // Only types opted in via FlushOnQuickExit flush at quick_exit
+    auto quickExitStatus = [](auto touch) {
+        pid_t child = ::fork();
+        if (child == 0) {
+            touch();
+            std::quick_exit(0);
+        }
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    };
+    REQUIRE(quickExitStatus([]() { dp::Singleton<QuickFlushProbe, dp::CreateUsingNew, dp::FastExit>::Instance(); }) == 42);
+    REQUIRE(quickExitStatus([]() { dp::Singleton<ExitOnlyFlushProbe, dp::CreateUsingNew, dp::FastExit>::Instance(); }) == 0);
+#endif
+
+    thread_safe_cout("[TEST] Fast-exit test completed");
+}
+
+// Test for per-CPU sharded singletons
+struct ShardedCounter {
+    std::atomic<long> value{ 0 };
+};
+
+TEST_CASE("SingletonPerCpu shards writes and reduces them", "[singleton][sharded]") {
+    thread_safe_cout("\n[TEST] Starting per-CPU sharding test");
+
+    using Counters = dp::SingletonPerCpu<ShardedCounter, dp::CreateUsingMalloc>;
+    const int NUM_THREADS = 8;
+    const int INCREMENTS = 1000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([]() {
+            for (int n = 0; n < INCREMENTS; ++n) {
+                Counters::Local().value.fetch_add(1, std::memory_order_relaxed);
+            }
+            });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    long total = Counters::Reduce(0L, [](long sum, ShardedCounter& c) { return sum + c.value.load(); });
+    REQUIRE(total == NUM_THREADS * INCREMENTS);
+
+    int shards = 0;
+    Counters::ForEach([&](ShardedCounter& c) {
+        ++shards;
+        REQUIRE(reinterpret_cast<std::uintptr_t>(&c) % dp::detail::kCacheLineSize == 0);
+        });
+    REQUIRE(shards >= 1);
+    REQUIRE(static_cast<std::size_t>(shards) <= Counters::ShardCount());
+
+    thread_safe_cout("[TEST] Per-CPU sharding test completed");
+}
+
+// Test for NUMA placement
+struct NumaTable {
+    NumaTable() { entries[0] = 1; entries[sizeof(entries) / sizeof(entries[0]) - 1] = 2; }
+    long entries[4096];
+};
+
+// Larger than any address space can map
+struct UnmappableTable {
+    char bytes[std::size_t(1) << 47];
+};
+
+TEST_CASE("NUMA creation policies place usable instances", "[singleton][numa]") {
+    thread_safe_cout("\n[TEST] Starting NUMA placement test");
+
+    SECTION("CreateOnNode") {
+        using S = dp::Singleton<NumaTable, dp::CreateOnNode>;
+        REQUIRE(S::Instance().entries[0] == 1);
+        REQUIRE(S::Instance().entries[4095] == 2);
+    }
+
+    SECTION("CreateInterleaved") {
+        using S = dp::Singleton<NumaTable, dp::CreateInterleaved>;
+        REQUIRE(S::Instance().entries[0] == 1);
+        REQUIRE(S::Instance().entries[4095] == 2);
+    }
+
+    SECTION("Per-node replicas") {
+        using Replicas = dp::SingletonPerCpu<NumaTable, dp::CreateOnNode,
+            dp::DefaultLifetime, dp::ClassLevelLockable, dp::PerNodeShards>;
+        REQUIRE(Replicas::ShardCount() == static_cast<std::size_t>(dp::detail::NumaNodeCount()));
+        REQUIRE(Replicas::Local().entries[4095] == 2);
+    }
+
+#if defined(__linux__)
+    SECTION("A failed mapping raises instead of returning null") {
+        REQUIRE_THROWS_AS(dp::CreateOnNode<UnmappableTable>::Create(), std::bad_alloc);
+        REQUIRE_THROWS_AS(dp::CreateInterleaved<UnmappableTable>::Create(), std::bad_alloc);
+    }
+#endif
+
+    thread_safe_cout("[TEST] NUMA placement test completed");
+}
+
+// Test for hot-swappable singletons
+struct VersionedConfig {
+    VersionedConfig(int v = 0) : version(v) { ++alive; }
+    VersionedConfig(const VersionedConfig& other) : version(other.version) { ++alive; }
+    ~VersionedConfig() { --alive; }
+    int version;
+    static std::atomic<int> alive;
+};
+
+std::atomic<int> VersionedConfig::alive{ 0 };
+
+// Destroyed after the swappable state it reads, since it is built first
+struct LateVersion {
+    LateVersion(int v = 0) : version(v) {}
+    ~LateVersion() { freed = freed || version == 5; }
+    int version;
+    static bool freed;
+};
+bool LateVersion::freed = false;
+
+using LateConfig = dp::SwappableSingleton<LateVersion>;
+struct LateConfigReader {
+    ~LateConfigReader() {
+        auto snapshot = LateConfig::Read();
+        _exit(!LateVersion::freed && snapshot->version == 5 ? 0 : 1);
+    }
+};
+
+TEST_CASE("SwappableSingleton publishes new versions to lock-free readers", "[singleton][swappable]") {
+    thread_safe_cout("\n[TEST] Starting swappable singleton test");
+
+    using Config = dp::SwappableSingleton<VersionedConfig>;
+
+    SECTION("Publish replaces the instance and releases the old one") {
+        REQUIRE(Config::Read()->version == 0);
+
+        std::shared_ptr<const VersionedConfig> pinned = Config::Acquire();
+        Config::Emplace(1);
+        REQUIRE(Config::Read()->version == 1);
+        REQUIRE(pinned->version == 0);
+        REQUIRE(VersionedConfig::alive == 2);
+
+        pinned.reset();
+        REQUIRE(VersionedConfig::alive == 1);
+
+        Config::Update([](VersionedConfig& c) { ++c.version; });
+        REQUIRE(Config::Read()->version == 2);
+        REQUIRE(VersionedConfig::alive == 1);
+    }
+
+    SECTION("Readers see monotonically newer versions while a writer publishes") {
+        const int NUM_READERS = 4;
+        const int NUM_VERSIONS = 200;
+        int start = Config::Read()->version;
+        std::atomic<bool> done{ false };
+        std::atomic<bool> ordered{ true };
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < NUM_READERS; ++i) {
+            readers.emplace_back([&]() {
+                int last = start;
+                while (!done.load()) {
+                    auto snapshot = Config::Read();
+                    if (snapshot->version < last) {
+                        ordered = false;
+                    }
+                    last = snapshot->version;
+                }
+                });
+        }
+
+        for (int v = 1; v <= NUM_VERSIONS; ++v) {
+            Config::Emplace(start + v);
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        REQUIRE(ordered);
+        REQUIRE(Config::Read()->version == start + NUM_VERSIONS);
+        REQUIRE(VersionedConfig::alive == 1);
+    }
+
+#if defined(__unix__)
+    SECTION("A snapshot taken during static destruction still sees a live version") {
+        pid_t child = ::fork();
+        if (child == 0) {
+            static LateConfigReader reader;
+            (void)reader;
+            LateConfig::Emplace(5);
+            std::exit(0);
+        }
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+    }
+#endif
+
+    thread_safe_cout("[TEST] Swappable singleton test completed");
+}
+
+// Test for the flat configuration table and registry
+TEST_CASE("ConfigTable interns entries and ConfigRegistry swaps them", "[singleton][config]") {
+    thread_safe_cout("\n[TEST] Starting config table test");
+
+    SECTION("Lookups return views into the table") {
+        dp::ConfigTable::Builder builder;
+        for (int i = 0; i < 1000; ++i) {
+            builder.Set("key" + std::to_string(i), "value" + std::to_string(i));
+        }
+        builder.Set("key7", "seven").Erase("key8");
+        dp::ConfigTable table = builder.Build();
+
+        REQUIRE(table.Size() == 999);
+        REQUIRE(table.Get("key0") == "value0");
+        REQUIRE(table.Get("key999") == "value999");
+        REQUIRE(table.Get("key7") == "seven");
+        REQUIRE_FALSE(table.Contains("key8"));
+        REQUIRE(table.Get("missing", "fallback") == "fallback");
+        REQUIRE(dp::ConfigTable().Get("key0").empty());
+
+        dp::ConfigTable copy = dp::ConfigTable::Builder(table).Set("extra", "").Build();
+        REQUIRE(copy.Size() == 1000);
+        REQUIRE(copy.Contains("extra"));
+        REQUIRE(copy.Get("key42") == table.Get("key42"));
+    }
+
+    SECTION("Registry views stay valid across a concurrent update") {
+        dp::ConfigRegistry::Set("server", "localhost");
+        std::shared_ptr<const dp::ConfigTable> pinned = dp::ConfigRegistry::Read().Share();
+        std::string_view server = pinned->Get("server");
+
+        std::thread writer([]() { dp::ConfigRegistry::Set("server", "example.org"); });
+        writer.join();
+
+        REQUIRE(server == "localhost");
+        REQUIRE(dp::ConfigRegistry::Read()->Get("server") == "example.org");
+    }
+
+    thread_safe_cout("[TEST] Config table test completed");
+}
+
+struct AdaptiveProbe {
+    int value = 0;
+};
+
+// Test for the adaptive threading model
+TEST_CASE("AdaptiveLockable locks only once the process is multithreaded", "[singleton][adaptive]") {
+    thread_safe_cout("\n[TEST] Starting adaptive locking test");
+    struct Tag {};
+    using Lock = dp::AdaptiveLockable<Tag>::Lock;
+
+    // Earlier tests ended the phase; start a fresh one
+    dp::detail::ResetThreadingPhase();
+
+    // Single-threaded: Lock is a no-op, so nesting it cannot deadlock
+    {
+        Lock outer;
+        Lock inner;
+        dp::EnterMultithreaded(); // Held no-op Locks must not unlock the mutex
+    }
+    REQUIRE(dp::IsMultithreaded());
+
+    // Built single-threaded, then shared by workers once the phase ends
+    dp::detail::ResetThreadingPhase();
+    using S = dp::Singleton<AdaptiveProbe, dp::CreateUsingNew, dp::DefaultLifetime, dp::AdaptiveLockable>;
+    AdaptiveProbe* first = &S::Instance();
+    REQUIRE_FALSE(dp::IsMultithreaded());
+    dp::EnterMultithreaded();
+    std::atomic<AdaptiveProbe*> seen{ nullptr };
+    std::thread([&]() { seen = &S::Instance(); }).join();
+    REQUIRE(seen == first);
+
+    // From then on it is a real mutex
+    long counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; ++i) {
+                Lock lock;
+                ++counter;
+            }
+            });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    REQUIRE(counter == 40000);
+    dp::detail::SingletonAccess<S>::Reset();
+
+    thread_safe_cout("[TEST] Adaptive locking test completed");
+}
+
+// Two fields a writer always keeps equal, so a torn read shows up
+struct AccessPair {
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    std::uint64_t padding[4] = {};
+};
+
+// Runs readers and writers concurrently against S; every write keeps a == b
+template <typename S>
+bool ReadersSeeConsistentWrites(int writes) {
+    std::atomic<bool> done{ false };
+    std::atomic<bool> consistent{ true };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                auto pair = S::Read();
+                if (pair->a != pair->b || pair->a < last) {
+                    consistent = false;
+                }
+                last = pair->a;
+            }
+            });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < writes; ++i) {
+                auto pair = S::Write();
+                ++pair->a;
+                std::this_thread::yield(); // Give readers a chance to see a half-done write
+                ++pair->b;
+            }
+            });
+    }
+    for (auto& t : writers) {
+        t.join();
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    return consistent && S::Read()->a == static_cast<std::uint64_t>(2 * writes);
+}
+
+// Test for guarded Read()/Write() access
+TEST_CASE("Access policies guard reads and writes after construction", "[singleton][access]") {
+    thread_safe_cout("\n[TEST] Starting access policy test");
+
+    SECTION("SharedMutexAccess") {
+        using S = dp::Singleton<dp::Guarded<AccessPair>>;
+        REQUIRE(ReadersSeeConsistentWrites<S>(500));
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("SeqLockAccess") {
+        using S = dp::Singleton<dp::Guarded<AccessPair, dp::SeqLockAccess>>;
+        REQUIRE(ReadersSeeConsistentWrites<S>(500));
+
+        // A read guard is a snapshot; Store() publishes a whole value
+        auto before = S::Read();
+        S::Instance().Store(AccessPair{ 7, 7, {} });
+        REQUIRE(before->a == 1000);
+        REQUIRE(S::Instance().Load().b == 7);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("PerCpuRwAccess") {
+        using S = dp::Singleton<dp::Guarded<AccessPair, dp::PerCpuRwAccess>>;
+        REQUIRE(ReadersSeeConsistentWrites<S>(500));
+
+        // Readers sharing a slot (same CPU, or the same thread) do not exclude each other
+        {
+            auto outer = S::Read();
+            auto inner = S::Read();
+            std::atomic<std::uint64_t> seen{ 0 };
+            std::thread([&]() { seen = S::Read()->a; }).join();
+            REQUIRE(seen == inner->a);
+        }
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("Constructor arguments reach the guarded value") {
+        using S = dp::Singleton<dp::Guarded<std::string>>;
+        S::Emplace(3, 'x');
+        REQUIRE(*S::Read() == "xxx");
+        S::Write()->append("y");
+        REQUIRE(S::Read()->size() == 4);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    thread_safe_cout("[TEST] Access policy test completed");
+}
+
+// Per-thread scratch buffer recycled across threads
+struct ScratchBuffer {
+    ScratchBuffer() { ++constructed; }
+    explicit ScratchBuffer(std::size_t size) : bytes(size) { ++constructed; }
+    ~ScratchBuffer() { ++destroyed; }
+    std::vector<char> bytes = std::vector<char>(4096);
+    int uses = 0;
+    static std::atomic<int> constructed;
+    static std::atomic<int> destroyed;
+    static std::atomic<int> recycled;
+};
+
+std::atomic<int> ScratchBuffer::constructed{ 0 };
+std::atomic<int> ScratchBuffer::destroyed{ 0 };
+std::atomic<int> ScratchBuffer::recycled{ 0 };
+
+void OnRecycle(ScratchBuffer& buffer) {
+    buffer.uses = 0;
+    ++ScratchBuffer::recycled;
+}
+
+namespace dp {
+    template <>
+    struct ThreadLocalPoolCapacity<ScratchBuffer> {
+        static constexpr std::size_t value = 2;
+    };
+}
+
+// Per-thread instance still in use by a thread started during static destruction
+struct LateScratch {
+    ~LateScratch() { ++destroyed; }
+    static std::atomic<int> destroyed;
+};
+
+std::atomic<int> LateScratch::destroyed{ 0 };
+
+using LateScratchSingleton = dp::Singleton<LateScratch, dp::CreateUsingNew, dp::DestroyAtThreadExit, dp::RecycledThreadLocal>;
+
+#if defined(__unix__) || defined(__APPLE__)
+// Destroyed after the pool has closed: its thread's instance must bypass the pool
+struct LateScratchUser {
+    ~LateScratchUser() {
+        std::thread([]() { LateScratchSingleton::Instance(); }).join();
+        ::_exit(LateScratch::destroyed == 2 ? 0 : 1); // The main thread's, then the late thread's
+    }
+};
+#endif
+
+// Test for recycled per-thread instances
+TEST_CASE("RecycledThreadLocal reuses instances of exited threads", "[singleton][recycled]") {
+    thread_safe_cout("\n[TEST] Starting recycled thread-local test");
+    using Scratch = dp::Singleton<ScratchBuffer, dp::CreateUsingNew, dp::DestroyAtThreadExit, dp::RecycledThreadLocal>;
+    ScratchBuffer::constructed = 0;
+    ScratchBuffer::destroyed = 0;
+    ScratchBuffer::recycled = 0;
+
+    // Threads started one after another share a single instance
+    std::atomic<bool> freshState{ true };
+    for (int i = 0; i < 5; ++i) {
+        std::thread([&]() {
+            if (Scratch::Instance().uses++ != 0) { // Reset by OnRecycle
+                freshState = false;
+            }
+            }).join();
+    }
+    REQUIRE(freshState);
+    REQUIRE(ScratchBuffer::constructed == 1);
+    REQUIRE(ScratchBuffer::recycled == 5);
+
+    // Concurrent threads each get their own; the pool keeps only two
+    std::atomic<int> arrived{ 0 };
+    std::vector<std::thread> threads;
+    std::mutex seenMutex;
+    std::vector<ScratchBuffer*> seen;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            ScratchBuffer* mine = &Scratch::Instance();
+            {
+                std::lock_guard<std::mutex> guard(seenMutex);
+                seen.push_back(mine);
+            }
+            ++arrived;
+            while (arrived < 4) {
+                std::this_thread::yield();
+            }
+            });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::sort(seen.begin(), seen.end());
+    REQUIRE(std::unique(seen.begin(), seen.end()) == seen.end());
+    REQUIRE(ScratchBuffer::constructed == 4);
+    REQUIRE(ScratchBuffer::destroyed == 2); // Returned to the creation policy once the pool was full
+
+    // Constructor arguments always build a new instance; a plain access reuses one
+    std::size_t sizes[3] = {};
+    std::thread([&]() { sizes[0] = Scratch::Instance(std::size_t(64)).bytes.size(); }).join();
+    std::thread([&]() { sizes[1] = Scratch::Emplace(std::size_t(128)).bytes.size(); }).join();
+    REQUIRE(ScratchBuffer::constructed == 6);
+    std::thread([&]() { sizes[2] = Scratch::Instance().bytes.size(); }).join();
+    REQUIRE(ScratchBuffer::constructed == 6);
+    REQUIRE(sizes[0] == 64);
+    REQUIRE(sizes[1] == 128);
+    REQUIRE(sizes[2] != 0);
+
+#if defined(__unix__) || defined(__APPLE__)
+    // A thread exiting after the pool closed destroys its instance instead
+    pid_t child = ::fork();
+    if (child == 0) {
+        static LateScratchUser user; // Constructed before the pool closer, so destroyed after it
+        (void)user;
+        LateScratchSingleton::Instance();
+        std::exit(0);
+    }
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+#endif
+
+    thread_safe_cout("[TEST] Recycled thread-local test completed");
+}
+
+// Handler for NotifyOnDeadReference
+std::atomic<int> g_deadReferences{ 0 };
+void CountDeadReference() {
+    ++g_deadReferences;
+}
+
+// Test for the exception-free dead-reference policies
+TEST_CASE("Dead-reference policies recover without exceptions", "[singleton][deadref]") {
+    SECTION("FallbackOnDeadReference hands out a fallback instance") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::FallbackOnDeadReference>;
+        STATIC_REQUIRE(dp::ProvidesFallbackInstance<dp::FallbackOnDeadReference<RefProbe>, RefProbe>::value);
+        RefProbe* live = &S::Instance();
+        live->value = 3;
+        dp::detail::SingletonAccess<S>::Destroy();
+
+        RefProbe& fallback = S::Instance();
+        REQUIRE(fallback.value == 7);
+        REQUIRE(&S::Instance() == &fallback); // Every later access gets the same fallback
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("NotifyOnDeadReference calls the handler and recreates") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::NotifyOnDeadReference<&CountDeadReference>::Policy>;
+        g_deadReferences = 0;
+        S::Instance().value = 3;
+        dp::detail::SingletonAccess<S>::Destroy();
+        REQUIRE(S::Instance().value == 7);
+        REQUIRE(g_deadReferences == 1);
+        REQUIRE(S::Instance().value == 7);
+        REQUIRE(g_deadReferences == 1);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    SECTION("AbortOnDeadReference aborts the process") {
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::AbortOnDeadReference>;
+        S::Instance();
+        dp::detail::SingletonAccess<S>::Destroy();
+        pid_t child = ::fork();
+        if (child == 0) {
+            ::signal(SIGABRT, SIG_DFL); // Die quietly, without the test runner's handler
+            ::freopen("/dev/null", "w", stderr);
+            S::Instance();
+            ::_exit(0);
+        }
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        REQUIRE(WIFSIGNALED(status));
+        REQUIRE(WTERMSIG(status) == SIGABRT);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+#endif
+}
+
+// Test for cache-line isolation of control state
+TEST_CASE("Lock words and instance pointers get cache lines of their own", "[singleton][layout]") {
+    constexpr std::size_t kLine = dp::detail::kCacheLineSize;
+    STATIC_REQUIRE(alignof(dp::detail::CacheLinePadded<std::atomic_flag>) == kLine);
+    STATIC_REQUIRE(sizeof(dp::detail::CacheLinePadded<std::atomic_flag>) == kLine);
+    STATIC_REQUIRE(sizeof(dp::detail::CacheLinePadded<dp::detail::SpinParkMutex>) == kLine);
+    STATIC_REQUIRE(sizeof(dp::detail::CacheLinePadded<std::mutex>) % kLine == 0);
+
+    // Policies that never destroy carry no dead-reference flag
+    STATIC_REQUIRE(sizeof(dp::detail::SingletonControl<TestSingleton, false>) == sizeof(std::atomic<TestSingleton*>));
+    STATIC_REQUIRE(sizeof(dp::detail::SingletonControl<TestSingleton, true>) > sizeof(std::atomic<TestSingleton*>));
+
+    // Neighbours in memory never share a line
+    dp::detail::CacheLinePadded<std::atomic<std::uint32_t>> words[2] = {};
+    auto line = [&](const void* p) { return reinterpret_cast<std::uintptr_t>(p) / kLine; };
+    REQUIRE(line(&words[0].value) != line(&words[1].value));
+
+    // Padding changes nothing about behaviour
+    using Spinning = dp::Singleton<TestSingleton, dp::CreateUsingNew, dp::PhoenixSingleton, dp::AtomicLockable>;
+    REQUIRE(&Spinning::Instance() == &Spinning::Instance());
+    dp::detail::SingletonAccess<Spinning>::Reset();
+}
+
+// Slow-to-build class for background construction; fails while failNext is set
+class SlowDictionary {
+public:
+    SlowDictionary() : builtBy(std::this_thread::get_id()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ++constructions;
+        if (failNext.exchange(false)) {
+            throw std::runtime_error("dictionary file missing");
+        }
+    }
+
+    const std::thread::id builtBy;
+    static std::atomic<int> constructions;
+    static std::atomic<bool> failNext;
+};
+
+std::atomic<int> SlowDictionary::constructions{ 0 };
+std::atomic<bool> SlowDictionary::failNext{ false };
+
+// Test for background construction
+TEST_CASE("Prefetch constructs the instance in the background", "[singleton][async]") {
+    thread_safe_cout("\n[TEST] Starting background construction test");
+    using Dictionary = dp::Singleton<SlowDictionary, dp::CreateUsingNew, dp::PhoenixSingleton>;
+    SlowDictionary::constructions = 0;
+
+    SECTION("Construction runs off the calling thread") {
+        Dictionary::Prefetch();
+        REQUIRE(Dictionary::InstanceAsync().get().builtBy != std::this_thread::get_id());
+        REQUIRE(SlowDictionary::constructions == 1);
+    }
+
+    SECTION("Instance() joins the construction under way") {
+        Dictionary::Prefetch();
+        SlowDictionary& instance = Dictionary::Instance();
+        REQUIRE(&Dictionary::InstanceAsync().get() == &instance);
+        REQUIRE(SlowDictionary::constructions == 1);
+
+        // Once built, the future is ready at once
+        REQUIRE(Dictionary::InstanceAsync().wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(SlowDictionary::constructions == 1);
+    }
+
+    SECTION("Failures reach the future and a later call retries") {
+        SlowDictionary::failNext = true;
+        REQUIRE_THROWS_AS(Dictionary::InstanceAsync().get(), std::runtime_error);
+        REQUIRE(&Dictionary::InstanceAsync().get() == &Dictionary::Instance());
+        REQUIRE(SlowDictionary::constructions == 2);
+    }
+
+    SECTION("Models that cannot construct in the background are rejected") {
+        // InstanceAsync() static_asserts on these
+        STATIC_REQUIRE(dp::IsSingleThreaded<dp::SingleThreaded<SlowDictionary>>::value);
+        STATIC_REQUIRE(dp::HasPerThreadInstances<dp::ThreadLocalSingleton<SlowDictionary>>::value);
+        STATIC_REQUIRE_FALSE(dp::IsSingleThreaded<dp::ClassLevelLockable<SlowDictionary>>::value);
+
+        // A no-lock phase ends before the background thread starts
+        using Adaptive = dp::Singleton<SlowDictionary, dp::CreateUsingNew, dp::PhoenixSingleton, dp::AdaptiveLockable>;
+        dp::detail::ResetThreadingPhase();
+        Adaptive::Prefetch();
+        REQUIRE(dp::IsMultithreaded());
+        REQUIRE(&Adaptive::Instance() == &Adaptive::InstanceAsync().get());
+        REQUIRE(SlowDictionary::constructions == 1);
+        dp::detail::SingletonAccess<Adaptive>::Reset();
+    }
+
+    SECTION("A destroyed instance is rebuilt") {
+        SlowDictionary* first = &Dictionary::InstanceAsync().get();
+        dp::detail::SingletonAccess<Dictionary>::Destroy();
+        SlowDictionary* second = &Dictionary::InstanceAsync().get();
+        REQUIRE(second == &Dictionary::Instance());
+        REQUIRE(SlowDictionary::constructions == 2);
+        (void)first;
+    }
+
+    dp::detail::SingletonAccess<Dictionary>::Reset();
+    thread_safe_cout("[TEST] Background construction test completed");
+}
+
+#if defined(DP_HAS_MAPPED_IMAGES)
+// Read-mostly table stored in a file-backed image
+struct MappedDictionary {
+    explicit MappedDictionary(int seed = 1) {
+        ++builds;
+        for (int i = 0; i < 1024; ++i) {
+            values[i] = seed * i;
+        }
+        middle = &values[512];
+    }
+
+    int values[1024];
+    dp::OffsetPtr<int> middle; // Survives being mapped at another address
+    static int builds;
+};
+
+int MappedDictionary::builds = 0;
+
+namespace dp {
+    template <>
+    struct MappedImageOf<MappedDictionary> {
+        static std::string Path() { return "/tmp/dp_mapped_test_" + std::to_string(::getpid()) + ".img"; }
+        static std::uint32_t Version() { return version; }
+        static std::uint32_t version;
+    };
+
+    std::uint32_t MappedImageOf<MappedDictionary>::version = 1;
+}
+
+// Test for file-backed singleton images
+TEST_CASE("CreateMapped attaches to an existing image", "[singleton][mapped]") {
+    thread_safe_cout("\n[TEST] Starting mapped image test");
+    using Dictionary = dp::Singleton<MappedDictionary, dp::CreateMapped, dp::PhoenixSingleton>;
+    using Policy = dp::CreateMapped<MappedDictionary>;
+    const std::string path = dp::MappedImageOf<MappedDictionary>::Path();
+    ::unlink(path.c_str());
+    MappedDictionary::builds = 0;
+
+    // First start builds the image from the constructor arguments
+    REQUIRE(Dictionary::Instance(3).values[10] == 30);
+    REQUIRE_FALSE(Policy::Attached());
+    REQUIRE(MappedDictionary::builds == 1);
+
+    // A restart attaches without constructing; offset pointers still resolve
+    dp::detail::SingletonAccess<Dictionary>::Destroy();
+    MappedDictionary& attached = Dictionary::Instance(5);
+    REQUIRE(Policy::Attached());
+    REQUIRE(MappedDictionary::builds == 1);
+    REQUIRE(attached.values[10] == 30);
+    REQUIRE(attached.middle.get() == &attached.values[512]);
+
+    // Writes are private to this process and never reach the file
+    attached.values[10] = -1;
+    dp::detail::SingletonAccess<Dictionary>::Destroy();
+    REQUIRE(Dictionary::Instance().values[10] == 30);
+
+    // A version bump invalidates the image
+    dp::detail::SingletonAccess<Dictionary>::Destroy();
+    dp::MappedImageOf<MappedDictionary>::version = 2;
+    REQUIRE(Dictionary::Instance(7).values[10] == 70);
+    REQUIRE_FALSE(Policy::Attached());
+    REQUIRE(MappedDictionary::builds == 2);
+
+    // A truncated image is rebuilt too
+    dp::detail::SingletonAccess<Dictionary>::Destroy();
+    REQUIRE(::truncate(path.c_str(), 16) == 0);
+    REQUIRE(Dictionary::Instance(2).values[10] == 20);
+    REQUIRE(MappedDictionary::builds == 3);
+
+    dp::detail::SingletonAccess<Dictionary>::Reset();
+    ::unlink(path.c_str());
+    ::unlink((path + ".lock").c_str());
+    thread_safe_cout("[TEST] Mapped image test completed");
+}
+#endif
+
+#if defined(DP_HAS_SHARED_MEMORY)
+// Table shared by every process through one shared memory segment
+struct SharedCatalog {
+    explicit SharedCatalog(int seed = 1) {
+        ++builds;
+        if (crashWhileBuilding) {
+            ::_exit(3);
+        }
+        for (int i = 0; i < 4096; ++i) {
+            values[i] = seed * i;
+        }
+        first = &values[0];
+    }
+
+    int values[4096];
+    dp::OffsetPtr<int> first;
+    static int builds;
+    static bool crashWhileBuilding;
+};
+
+int SharedCatalog::builds = 0;
+bool SharedCatalog::crashWhileBuilding = false;
+
+namespace dp {
+    template <>
+    struct SharedMemoryOf<SharedCatalog> {
+        // Fixed at the first call, before the test forks
+        static std::string Name() {
+            static const std::string name = "/dp_shm_test_" + std::to_string(::getpid());
+            return name;
+        }
+        static std::uint32_t Version() { return 1; }
+    };
+}
+
+// Test for the cross-process shared memory policy
+TEST_CASE("CreateInSharedMemory builds once per host", "[singleton][shm]") {
+    thread_safe_cout("\n[TEST] Starting shared memory test");
+    using Catalog = dp::Singleton<SharedCatalog, dp::CreateInSharedMemory, dp::PhoenixSingleton>;
+    using Policy = dp::CreateInSharedMemory<SharedCatalog>;
+    Policy::Remove();
+
+    auto waitExit = [](pid_t pid) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+    };
+
+    // A builder dying mid-construction leaves its pid in the segment
+    pid_t crashed = ::fork();
+    if (crashed == 0) {
+        SharedCatalog::crashWhileBuilding = true;
+        Catalog::Instance();
+        ::_exit(0);
+    }
+    REQUIRE(waitExit(crashed) == 3);
+
+    // Of several workers exactly one takes over and builds; the rest attach
+    const int NUM_WORKERS = 3;
+    std::vector<pid_t> workers;
+    for (int i = 0; i < NUM_WORKERS; ++i) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            SharedCatalog& catalog = Catalog::Instance(2);
+            bool valid = catalog.values[10] == 20 && catalog.first.get() == &catalog.values[0];
+            ::_exit(valid ? (Policy::Attached() ? 1 : 2) : 9);
+        }
+        workers.push_back(pid);
+    }
+    int builders = 0;
+    int attached = 0;
+    for (pid_t pid : workers) {
+        int code = waitExit(pid);
+        builders += code == 2;
+        attached += code == 1;
+    }
+    REQUIRE(builders == 1);
+    REQUIRE(attached == NUM_WORKERS - 1);
+
+    // This process attaches too, constructing nothing
+    SharedCatalog& catalog = Catalog::Instance(5);
+    REQUIRE(Policy::Attached());
+    REQUIRE(SharedCatalog::builds == 0);
+    REQUIRE(catalog.values[4095] == 2 * 4095);
+
+    // The instance is mapped read-only
+    pid_t writer = ::fork();
+    if (writer == 0) {
+        ::signal(SIGSEGV, SIG_DFL); // Die quietly, without the test runner's handler
+        Catalog::Instance().values[0] = 1;
+        ::_exit(0);
+    }
+    REQUIRE(waitExit(writer) == -SIGSEGV);
+
+    dp::detail::SingletonAccess<Catalog>::Reset();
+    Policy::Remove();
+    thread_safe_cout("[TEST] Shared memory test completed");
+}
+#endif
+
+// Keyed instance that remembers its key and counts constructions
+class ShardPool {
+public:
+    explicit ShardPool(std::string n = "default") : name(std::move(n)) { ++constructions; }
+    std::string name;
+    static std::atomic<int> constructions;
+};
+
+std::atomic<int> ShardPool::constructions{ 0 };
+
+// Test for keyed singletons
+TEST_CASE("Multiton creates one instance per key", "[singleton][multiton]") {
+    thread_safe_cout("\n[TEST] Starting multiton test");
+
+    SECTION("Concurrent first accesses create each key once") {
+        using Pools = dp::Multiton<int, ShardPool, dp::CreateUsingNew, dp::PhoenixSingleton>;
+        ShardPool::constructions = 0;
+        const int NUM_THREADS = 4;
+        const int NUM_KEYS = 200; // Forces several table growths
+
+        std::vector<std::thread> threads;
+        std::atomic<bool> consistent{ true };
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&]() {
+                for (int key = 0; key < NUM_KEYS; ++key) {
+                    if (&Pools::Instance(key) != &Pools::Instance(key)) {
+                        consistent = false;
+                    }
+                }
+                });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        REQUIRE(consistent);
+        REQUIRE(ShardPool::constructions == NUM_KEYS);
+        REQUIRE(Pools::Find(NUM_KEYS) == nullptr);
+        REQUIRE(Pools::Find(7) == &Pools::Instance(7));
+
+        int live = 0;
+        Pools::ForEach([&live](int, ShardPool&) { ++live; });
+        REQUIRE(live == NUM_KEYS);
+
+        // Destruction keeps the keys; Phoenix recreates on the next access
+        dp::detail::SingletonAccess<Pools>::Destroy();
+        REQUIRE(Pools::Find(7) == nullptr);
+        Pools::Instance(7);
+        REQUIRE(ShardPool::constructions == NUM_KEYS + 1);
+    }
+
+    SECTION("String keys take constructor arguments on first use") {
+        using Loggers = dp::Multiton<std::string, ShardPool>;
+        REQUIRE(Loggers::Instance("net", "network").name == "network");
+        REQUIRE(Loggers::Instance("net", "ignored").name == "network");
+        REQUIRE(Loggers::Instance("disk").name == "default");
+        dp::detail::SingletonAccess<Loggers>::Reset();
+    }
+
+    SECTION("Dense integer keys index a fixed array") {
+        using Dense = dp::DenseMultiton<8, ShardPool, dp::CreateUsingNew, dp::DefaultLifetime>;
+        REQUIRE(&Dense::Instance(3) == &Dense::Instance(3));
+        REQUIRE(&Dense::Instance(3) != &Dense::Instance(4));
+        REQUIRE(Dense::Find(5) == nullptr);
+        REQUIRE_THROWS_AS(Dense::Instance(8), std::out_of_range);
+
+        dp::detail::SingletonAccess<Dense>::Destroy();
+        REQUIRE_THROWS_AS(Dense::Instance(3), std::logic_error);
+        dp::detail::SingletonAccess<Dense>::Reset();
+    }
+
+    thread_safe_cout("[TEST] Multiton test completed");
+}
+
+// Class measured by the instrumentation policy
+struct InstrumentedProbe {
+    InstrumentedProbe() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+};
+
+template <>
+struct dp::InstrumentationName<InstrumentedProbe> {
+    static std::string Get() { return "InstrumentedProbe"; }
+};
+
+// Test for the instrumentation policy
+TEST_CASE("Instrumented singletons record creation, contention and access", "[singleton][instrumentation]") {
+    thread_safe_cout("\n[TEST] Starting instrumentation test");
+
+    using S = dp::Singleton<InstrumentedProbe, dp::CreateUsingNew, dp::PhoenixSingleton,
+        dp::ClassLevelLockable, dp::Instrumented>;
+    const dp::SingletonStats& stats = dp::Instrumented<InstrumentedProbe>::Stats();
+
+    const int NUM_THREADS = 4;
+    const int NUM_CALLS = 1024;
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (int j = 0; j < NUM_CALLS; ++j) {
+                S::Instance();
+            }
+            });
+    }
+    start = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(stats.constructions == 1);
+    REQUIRE(stats.lastConstructionNs >= 2000000);
+    REQUIRE(stats.lockAcquisitions >= 1);
+    REQUIRE(stats.lostRaces == stats.lockAcquisitions - 1);
+    REQUIRE(stats.accesses == static_cast<std::uint64_t>(NUM_THREADS * NUM_CALLS));
+
+    std::uint64_t histogramTotal = 0;
+    for (const auto& bucket : stats.lockWaitHistogram) {
+        histogramTotal += bucket;
+    }
+    REQUIRE(histogramTotal == stats.lockAcquisitions);
+
+    dp::detail::SingletonAccess<S>::Destroy();
+    S::Instance();
+    REQUIRE(stats.constructions == 2);
+
+    std::ostringstream json;
+    dp::InstrumentationRegistry::Global().WriteJson(json);
+    REQUIRE(json.str().find("{\"name\":\"InstrumentedProbe\",\"constructions\":2,") != std::string::npos);
+
+    std::ostringstream prometheus;
+    dp::InstrumentationRegistry::Global().WritePrometheus(prometheus);
+    REQUIRE(prometheus.str().find("dp_singleton_constructions_total{singleton=\"InstrumentedProbe\"} 2\n") != std::string::npos);
+    REQUIRE(prometheus.str().find("dp_singleton_lock_wait_seconds_bucket{singleton=\"InstrumentedProbe\",le=\"+Inf\"}") != std::string::npos);
+
+    thread_safe_cout("[TEST] Instrumentation test completed");
+}
+
+// Class whose construction can be made to fail, for OnceInit rollback
+class OnceProbe {
+public:
+    OnceProbe() {
+        // Widen the window in which other threads arrive and wait
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (failuresLeft.load() > 0) {
+            --failuresLeft;
+            throw std::runtime_error("construction failed");
+        }
+        ++constructions;
+    }
+
+    static std::atomic<int> failuresLeft;
+    static std::atomic<int> constructions;
+};
+
+std::atomic<int> OnceProbe::failuresLeft{ 0 };
+std::atomic<int> OnceProbe::constructions{ 0 };
+
+// Test for the once-initialization threading model
+TEST_CASE("OnceInit constructs exactly once and rolls back on failure", "[singleton][once]") {
+    thread_safe_cout("\n[TEST] Starting once-init test");
+
+    using S = dp::Singleton<OnceProbe, dp::CreateUsingNew, dp::PhoenixSingleton, dp::OnceInit>;
+
+    SECTION("A thundering herd sees one construction and one instance") {
+        dp::detail::SingletonAccess<S>::Reset();
+        OnceProbe::constructions = 0;
+        const int NUM_THREADS = 8;
+        std::atomic<bool> start{ false };
+        std::vector<OnceProbe*> seen(NUM_THREADS, nullptr);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&, i]() {
+                while (!start.load()) {
+                    std::this_thread::yield();
+                }
+                seen[i] = &S::Instance();
+                });
+        }
+        start = true;
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        REQUIRE(OnceProbe::constructions == 1);
+        for (OnceProbe* p : seen) {
+            REQUIRE(p == seen[0]);
+        }
+    }
+
+    SECTION("A throwing constructor lets another thread retry") {
+        dp::detail::SingletonAccess<S>::Reset();
+        OnceProbe::constructions = 0;
+        OnceProbe::failuresLeft = 1;
+
+        const int NUM_THREADS = 4;
+        std::atomic<int> failures{ 0 };
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&]() {
+                try {
+                    S::Instance();
+                }
+                catch (const std::runtime_error&) {
+                    ++failures;
+                }
+                });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        REQUIRE(failures == 1);
+        REQUIRE(OnceProbe::constructions == 1);
+        REQUIRE(&S::Instance() == &S::Instance());
+    }
+
+    SECTION("Destruction resets the state for the lifetime policy") {
+        S::Instance();
+        dp::detail::SingletonAccess<S>::Destroy();
+        int before = OnceProbe::constructions;
+        S::Instance(); // PhoenixSingleton recreates
+        REQUIRE(OnceProbe::constructions == before + 1);
+
+        using Strict = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::DefaultLifetime, dp::OnceInit>;
+        Strict::Instance();
+        dp::detail::SingletonAccess<Strict>::Destroy();
+        REQUIRE_THROWS_AS(Strict::Instance(), std::logic_error);
+    }
+
+    thread_safe_cout("[TEST] Once-init test completed");
+}
+
+// Policy that is missing Destroy(T*)
+template <typename T>
+struct IncompleteCreation {
+    static T* Create() { return new T(); }
+};
+
+// Test for compile-time policy validation
+TEST_CASE("Policy traits classify and validate policies", "[singleton][traits]") {
+    thread_safe_cout("\n[TEST] Starting policy traits test");
+
+    SECTION("Each policy category is recognized") {
+        STATIC_REQUIRE(dp::IsCreationPolicy<dp::CreateUsingMalloc<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE(dp::IsCreationPolicy<dp::CreateInArena<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE_FALSE(dp::IsCreationPolicy<IncompleteCreation<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE_FALSE(dp::IsCreationPolicy<dp::NoDestroy<TestSingleton>, TestSingleton>::value);
+
+        STATIC_REQUIRE(dp::IsLifetimePolicy<dp::DefaultLifetime<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE(dp::IsLifetimePolicy<dp::SingletonWithLongevity<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE_FALSE(dp::IsLifetimePolicy<dp::CreateUsingNew<TestSingleton>, TestSingleton>::value);
+
+        STATIC_REQUIRE(dp::IsThreadingModel<dp::SpinParkLockable<TestSingleton>>::value);
+        STATIC_REQUIRE(dp::IsThreadingModel<dp::ThreadLocalSingleton<TestSingleton>>::value);
+        STATIC_REQUIRE_FALSE(dp::IsThreadingModel<dp::PhoenixSingleton<TestSingleton>>::value);
+    }
+
+    SECTION("Never-destroying lifetimes drop dead-reference tracking") {
+        STATIC_REQUIRE_FALSE(dp::DestroysInstance<dp::NoDestroy<TestSingleton>>::value);
+        STATIC_REQUIRE_FALSE(dp::DestroysInstance<dp::FastExit<TestSingleton>>::value);
+        STATIC_REQUIRE(dp::DestroysInstance<dp::DefaultLifetime<TestSingleton>>::value);
+
+        // A forced destruction is then never reported as a dead reference
+        using S = dp::Singleton<RefProbe, dp::CreateUsingNew, dp::NoDestroy>;
+        S::Instance().value = 3;
+        dp::detail::SingletonAccess<S>::Destroy();
+        REQUIRE(S::Instance().value == 7);
+    }
+
+    SECTION("Per-thread instances accept only thread-exit-safe lifetimes") {
+        STATIC_REQUIRE(dp::SupportsPerThreadInstances<dp::DestroyAtThreadExit<TestSingleton>>::value);
+        STATIC_REQUIRE(dp::SupportsPerThreadInstances<dp::PhoenixSingleton<TestSingleton>>::value);
+        STATIC_REQUIRE_FALSE(dp::SupportsPerThreadInstances<dp::DefaultLifetime<TestSingleton>>::value);
+        STATIC_REQUIRE_FALSE(dp::SupportsPerThreadInstances<dp::FastExit<TestSingleton>>::value);
+        STATIC_REQUIRE_FALSE(dp::SupportsPerThreadInstances<dp::NoDestroy<TestSingleton>>::value);
+        STATIC_REQUIRE(dp::IsSingleThreaded<dp::SingleThreaded<TestSingleton>>::value);
+    }
+
+    SECTION("Containers reject lifetimes that follow one instance") {
+        STATIC_REQUIRE(dp::SchedulesOneInstance<dp::FastExit<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE(dp::SchedulesOneInstance<dp::SingletonWithLongevity<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE_FALSE(dp::SchedulesOneInstance<dp::NoDestroy<TestSingleton>, TestSingleton>::value);
+        STATIC_REQUIRE_FALSE(dp::SchedulesOneInstance<dp::DefaultLifetime<TestSingleton>, TestSingleton>::value);
+    }
+
+    thread_safe_cout("[TEST] Policy traits test completed");
+}
+
+// Class without a default constructor that counts its copies
+class EmplaceProbe {
+public:
+    EmplaceProbe(std::string name, std::vector<int> rows) : name(std::move(name)), rows(std::move(rows)) {}
+    EmplaceProbe(const EmplaceProbe& other) : name(other.name), rows(other.rows) { ++copies; }
+    EmplaceProbe(EmplaceProbe&& other) noexcept : name(std::move(other.name)), rows(std::move(other.rows)) {}
+
+    std::string name;
+    std::vector<int> rows;
+    static int copies;
+};
+
+int EmplaceProbe::copies = 0;
+
+// Test for constructor-argument forwarding
+TEST_CASE("Creation policies forward constructor arguments", "[singleton][emplace]") {
+    thread_safe_cout("\n[TEST] Starting emplace test");
+
+    SECTION("Emplace constructs once and rejects a second construction") {
+        using S = dp::Singleton<EmplaceProbe, dp::CreateUsingMalloc>;
+        std::vector<int> rows(1000, 7);
+        const int* data = rows.data();
+        EmplaceProbe& instance = S::Emplace("table", std::move(rows));
+
+        REQUIRE(instance.name == "table");
+        REQUIRE(instance.rows.data() == data); // Moved, never copied
+        REQUIRE_THROWS_AS(S::Emplace("again", std::vector<int>()), std::logic_error);
+        REQUIRE(&S::Instance() == &instance);
+        dp::detail::SingletonAccess<S>::Reset();
+        REQUIRE_THROWS_AS(S::Instance(), std::logic_error);
+    }
+
+    SECTION("Instance(args) uses the arguments only on first access") {
+        using S = dp::Singleton<EmplaceProbe, dp::CreateUsingSharedPtr, dp::PhoenixSingleton>;
+        REQUIRE(S::Instance("first", std::vector<int>{ 1 }).name == "first");
+        REQUIRE(S::Instance("second", std::vector<int>{ 2 }).name == "first");
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("A prebuilt instance is moved in") {
+        using S = dp::Singleton<EmplaceProbe, dp::CreateUsingNew, dp::DefaultLifetime, dp::SpinParkLockable>;
+        EmplaceProbe prebuilt("prebuilt", std::vector<int>{ 1, 2, 3 });
+        int copies = EmplaceProbe::copies;
+        REQUIRE(S::Emplace(std::move(prebuilt)).rows.size() == 3);
+        REQUIRE(EmplaceProbe::copies == copies);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("Thread-local instances are emplaced per thread") {
+        using S = dp::Singleton<EmplaceProbe, dp::CreateUsingNew, dp::DestroyAtThreadExit, dp::ThreadLocalSingleton>;
+        S::Emplace("main", std::vector<int>());
+        std::string workerName;
+        std::thread worker([&workerName]() { workerName = S::Instance("worker", std::vector<int>()).name; });
+        worker.join();
+
+        REQUIRE(S::Instance().name == "main");
+        REQUIRE(workerName == "worker");
+        REQUIRE_THROWS_AS(S::Emplace("main", std::vector<int>()), std::logic_error);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    SECTION("Concurrent Emplace builds once and rejects the rest") {
+        using S = dp::Singleton<EmplaceProbe, dp::CreateUsingNew, dp::DefaultLifetime, dp::OnceInit>;
+        std::atomic<int> built{ 0 };
+        std::atomic<int> rejected{ 0 };
+        std::vector<std::string> names(4);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                try {
+                    names[t] = S::Emplace("emplacer " + std::to_string(t), std::vector<int>()).name;
+                    ++built;
+                }
+                catch (const std::logic_error&) {
+                    ++rejected;
+                }
+                });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        REQUIRE(built == 1);
+        REQUIRE(rejected == 3);
+        REQUIRE(std::find(names.begin(), names.end(), S::Instance().name) != names.end());
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+
+    thread_safe_cout("[TEST] Emplace test completed");
+}
+
+// Class recreated through the arena creation policy
+class ArenaProbe {
+public:
+    ArenaProbe() : generation(++created) {}
+    int generation;
+    static int created;
+};
+
+int ArenaProbe::created = 0;
+
+#if defined(__cpp_lib_memory_resource)
+// Routes PmrAllocator<T, ArenaTestResource> to a counting resource
+struct ArenaTestResource {};
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+static CountingResource countingResource;
+
+template <>
+struct dp::MemoryResourceFor<ArenaTestResource> {
+    static std::pmr::memory_resource* Get() { return &countingResource; }
+};
+#endif
+
+// Test for the arena and allocator creation policies
+TEST_CASE("Arena creation policy recycles recreated instances", "[singleton][arena]") {
+    thread_safe_cout("\n[TEST] Starting arena creation policy test");
+
+    SECTION("A Phoenix singleton comes back in the same block") {
+        using S = dp::Singleton<ArenaProbe, dp::CreateInArena, dp::PhoenixSingleton>;
+        ArenaProbe* first = &S::Instance();
+        int generation = first->generation;
+
+        dp::detail::SingletonAccess<S>::Destroy();
+        ArenaProbe* second = &S::Instance();
+        REQUIRE(second == first);
+        REQUIRE(second->generation == generation + 1);
+    }
+
+    SECTION("Arena allocations are packed and suitably aligned") {
+        struct alignas(64) Wide { char bytes[64]; };
+        dp::ArenaAllocator<Wide> allocator;
+        Wide* a = allocator.allocate(1);
+        Wide* b = allocator.allocate(1);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(a) % 64 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+        allocator.deallocate(b, 1);
+        REQUIRE(allocator.allocate(1) == b);
+    }
+
+#if defined(__cpp_lib_memory_resource)
+    SECTION("CreateUsingAllocator plugs in a memory resource") {
+        using Policy = dp::CreateUsingAllocator<dp::PmrAllocator<char, ArenaTestResource>>;
+        using S = dp::Singleton<ArenaProbe, Policy::Policy, dp::PhoenixSingleton>;
+        int before = countingResource.allocations;
+        S::Instance();
+        REQUIRE(countingResource.allocations == before + 1);
+        dp::detail::SingletonAccess<S>::Reset();
+    }
+#endif
+
+    thread_safe_cout("[TEST] Arena creation policy test completed");
+}
+
+// Reads back everything written to a temporary file
+static std::vector<std::string> ReadLines(std::FILE* file) {
+    std::vector<std::string> lines;
+    std::rewind(file);
+    std::string line;
+    for (int c; (c = std::fgetc(file)) != EOF;) {
+        if (c == '\n') {
+            lines.push_back(line);
+            line.clear();
+        }
+        else {
+            line += static_cast<char>(c);
+        }
+    }
+    return lines;
+}
+
+// Test for the asynchronous logger
+TEST_CASE("AsyncLogger writes every queued message in order", "[singleton][logger]") {
+    thread_safe_cout("\n[TEST] Starting async logger test");
+
+    SECTION("Flush waits for concurrent producers' messages") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const int NUM_THREADS = 4;
+        const int NUM_MESSAGES = 2000; // Per thread; several times the ring capacity
+
+        {
+            dp::AsyncLogger logger(fileno(file));
+            std::vector<std::thread> producers;
+            for (int t = 0; t < NUM_THREADS; ++t) {
+                producers.emplace_back([&logger, t]() {
+                    for (int i = 0; i < NUM_MESSAGES; ++i) {
+                        logger.Log(std::to_string(t) + ":" + std::to_string(i));
+                    }
+                    });
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            logger.Flush();
+            REQUIRE(logger.Written() == static_cast<std::size_t>(NUM_THREADS * NUM_MESSAGES));
+        }
+
+        // Each producer's messages appear in the order it logged them
+        std::vector<int> next(NUM_THREADS, 0);
+        std::vector<std::string> lines = ReadLines(file);
+        REQUIRE(lines.size() == static_cast<std::size_t>(NUM_THREADS * NUM_MESSAGES));
+        bool ordered = true;
+        for (const std::string& line : lines) {
+            int t = std::stoi(line.substr(0, line.find(':')));
+            ordered = ordered && std::stoi(line.substr(line.find(':') + 1)) == next[t]++;
+        }
+        REQUIRE(ordered);
+        std::fclose(file);
+    }
+
+    SECTION("Destruction drains the queue and truncates long messages") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        {
+            dp::AsyncLogger logger(fileno(file));
+            logger.Log("first");
+            logger.Log(std::string(1000, 'x'));
+        }
+        std::vector<std::string> lines = ReadLines(file);
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[0] == "first");
+        REQUIRE(lines[1].size() == dp::AsyncLogger::kMaxMessage);
+        std::fclose(file);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    SECTION("A full non-blocking sink delays records instead of dropping them") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+        const int NUM_MESSAGES = 4000; // Well over a pipe buffer
+        const std::string message(63, 'p');
+
+        std::atomic<int> received{ 0 };
+        std::thread reader([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let the pipe fill up
+            char buffer[4096];
+            ssize_t n;
+            while ((n = ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+                received += static_cast<int>(std::count(buffer, buffer + n, '\n'));
+            }
+            });
+        {
+            dp::AsyncLogger logger(fds[1]);
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                logger.Log(message);
+            }
+        }
+        ::close(fds[1]); // Ends the reader once everything is read
+        reader.join();
+        ::close(fds[0]);
+        REQUIRE(received == NUM_MESSAGES);
+    }
+#endif
+
+    thread_safe_cout("[TEST] Async logger test completed");
+}
+
+// Test for eager singletons
+TEST_CASE("Eager singletons are built ahead of first access", "[singleton][eager]") {
+    thread_safe_cout("\n[TEST] Starting eager singleton test");
+
+    SECTION("InitAtStartup builds during static initialization") {
+        using Eager = dp::EagerSingleton<EagerProbe>;
+        REQUIRE(Eager::Instance().builtBeforeMain);
+        REQUIRE(&Eager::Instance() == &Eager::Instance());
+    }
+
+    SECTION("InitExplicitly builds at InitializeAll()") {
+        using Deferred = dp::EagerSingleton<DeferredProbe, dp::InitExplicitly>;
+        // Registered during static initialization, but not constructed yet
+        REQUIRE(DeferredProbe::constructions == 0);
+
+        dp::InitializeAll();
+        dp::InitializeAll();
+        REQUIRE(DeferredProbe::constructions == 1);
+        REQUIRE(&Deferred::Instance() == &Deferred::Instance());
+    }
+
+    thread_safe_cout("[TEST] Eager singleton test completed");
+}
+
 // Additional test for proper singleton destruction
 TEST_CASE("Singletons are properly destroyed", "[singleton][cleanup]") {
     thread_safe_cout("\n[TEST] Testing singleton destruction");
@@ -210,6 +1960,7 @@ TEST_CASE("Singletons are properly destroyed", "[singleton][cleanup]") {
 }
 
 int main(int argc, char* argv[]) {
+    mainStarted = true;
     thread_safe_cout("[MAIN] Starting Singleton tests");
 
     // Run the tests